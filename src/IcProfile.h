@@ -0,0 +1,51 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#ifdef IC_DEBUG_BUILD
+    #define IC_ENABLE_PROFILING
+#endif
+
+#ifdef IC_ENABLE_PROFILING
+    #include "profile/Profiler.h"
+    #include "profile/FsCounters.h"
+
+    #define IC_PROFILE_CONCAT_IMPL(x, y) x##y
+    #define IC_PROFILE_CONCAT(x, y) IC_PROFILE_CONCAT_IMPL(x, y)
+
+    #define IC_PROFILE_SCOPE(name)                                                                                          \
+        static const auto IC_PROFILE_CONCAT(icProfilePhase, __LINE__){ ::ic::profile::Profiler::Register(name) };          \
+        const ::ic::profile::Profiler::Scope IC_PROFILE_CONCAT(icProfileScope, __LINE__){ IC_PROFILE_CONCAT(icProfilePhase, __LINE__) }
+
+    #define IC_PROFILE_BEGIN_FRAME() ::ic::profile::Profiler::BeginFrame()
+    #define IC_PROFILE_END_FRAME(rendered) ::ic::profile::Profiler::EndFrame(rendered)
+
+    // counts a filesystem call, e.g. IC_PROFILE_FS(STAT, "InfoWidget::Render", std::filesystem::is_directory(path))
+    #define IC_PROFILE_FS(call, site, ...)                                                                                  \
+        [&]() -> decltype(auto) {                                                                                           \
+            static const auto icFsSite{ ::ic::profile::FsCounters::Register(::ic::profile::FsCall::call, site) };         \
+            const ::ic::profile::FsCounters::Scope icFsScope{ icFsSite };                                                   \
+            return __VA_ARGS__;                                                                                             \
+        }()
+#else
+    #define IC_PROFILE_SCOPE(name)
+    #define IC_PROFILE_BEGIN_FRAME()
+    #define IC_PROFILE_END_FRAME(rendered)
+    #define IC_PROFILE_FS(call, site, ...) (__VA_ARGS__)
+#endif
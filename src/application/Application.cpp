@@ -16,14 +16,21 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
+#include <algorithm>
 #include "Application.h"
 #include "IcAssert.h"
+#include "IcProfile.h"
 #include "Window.h"
+#include "FramePacer.h"
 #include "Util.h"
 #include "data/View.h"
+#include "data/Prefetcher.h"
 #include "widget/MainMenuWidget.h"
 #include "widget/BottomMenuWidget.h"
+#include "widget/FinderWidget.h"
+#include "widget/OperationsWidget.h"
 #include "widget/DebugWidget.h"
+#include "operation/OperationQueue.h"
 #include "vendor/imgui/imgui_impl_sdl2.h"
 
 //-------------------------------------------------
@@ -40,6 +47,8 @@ ic::application::Application::Application()
 ic::application::Application::~Application() noexcept
 {
     IC_LOG_DEBUG("[Application::~Application()] Destruct Application.");
+
+    executor.Stop();
 }
 
 //-------------------------------------------------
@@ -70,19 +79,47 @@ void ic::application::Application::Init()
         INI.Get<int>("window", "height")
     );
 
+    listing_cache.SetBudget(static_cast<std::size_t>(INI.Get<int>("cache", "listing_budget_mb", 64)) * 1024 * 1024);
+
+    m_framePacer = std::make_unique<FramePacer>(
+        INI.Get<bool>("render", "idle", true),
+        INI.Get<int>("render", "max_fps", 60),
+        INI.Get<int>("render", "busy_fps", 15),
+        std::chrono::milliseconds(INI.Get<int>("render", "idle_poll_ms", 250))
+    );
+
+    // a finished async call is shown at once, even if the loop is idle
+    executor.SetWakeUp(&Window::WakeUp);
+    executor.Start();
+
+    m_prefetcher = std::make_unique<data::Prefetcher>();
+
     leftView = std::make_unique<data::View>(data::ViewType::LEFT);
     rightView = std::make_unique<data::View>(data::ViewType::RIGHT);
 
+    m_operationQueue = std::make_unique<operation::OperationQueue>(static_cast<std::size_t>(INI.Get<int>("jobs", "workers", 2)));
+
     m_mainMenuWidget = std::make_unique<widget::MainMenuWidget>(leftView.get(), rightView.get());
-    m_bottomMenuWidget = std::make_unique<widget::BottomMenuWidget>(leftView.get(), rightView.get());
+    m_bottomMenuWidget = std::make_unique<widget::BottomMenuWidget>(leftView.get(), rightView.get(), m_operationQueue.get());
+    m_finderWidget = std::make_unique<widget::FinderWidget>(leftView.get(), rightView.get());
+    m_operationsWidget = std::make_unique<widget::OperationsWidget>(m_operationQueue.get());
 
     IC_LOG_DEBUG("[Application::Init()] The application was successfully initialized.");
 }
 
-void ic::application::Application::HandleSdlEvents(bool& t_running)
+bool ic::application::Application::HandleSdlEvents(bool& t_running, const int t_timeout)
 {
     SDL_Event event;
-    while (SDL_PollEvent(&event))
+
+    // only the first event is waited for
+    auto received{ t_timeout > 0 ? SDL_WaitEventTimeout(&event, t_timeout) : SDL_PollEvent(&event) };
+    const auto input{ received != 0 };
+
+    // the frame starts when the loop wakes up
+    IC_PROFILE_BEGIN_FRAME();
+    IC_PROFILE_SCOPE("Application::HandleSdlEvents");
+
+    while (received)
     {
         ImGui_ImplSDL2_ProcessEvent(&event);
 
@@ -95,17 +132,29 @@ void ic::application::Application::HandleSdlEvents(bool& t_running)
         {
             m_window->OnSdlEvent(&event);
         }
+
+        received = SDL_PollEvent(&event);
     }
+
+    return input;
 }
 
 void ic::application::Application::Update()
 {
+    IC_PROFILE_SCOPE("Application::Update");
+
     leftView->Update();
     rightView->Update();
+
+    m_prefetcher->Update();
+
+    ApplyOperationChanges();
 }
 
 void ic::application::Application::Render() const
 {
+    IC_PROFILE_SCOPE("Application::Render");
+
     m_mainMenuWidget->Render();
 
     leftView->SetPosition(0.0f, ImGui::GetFrameHeight());
@@ -124,7 +173,10 @@ void ic::application::Application::Render() const
     m_bottomMenuWidget->SetSize(static_cast<float>(m_window->width), ImGui::GetFrameHeight() * 2.0f);
     m_bottomMenuWidget->Render();
 
-#ifdef IC_DEBUG_BUILD
+    m_finderWidget->Render();
+    m_operationsWidget->Render();
+
+#if defined(IC_DEBUG_BUILD) || defined(IC_ENABLE_PROFILING)
     widget::DebugWidget::Render(this);
 #endif
 }
@@ -140,12 +192,27 @@ void ic::application::Application::Loop()
     bool running{ true };
     while (running)
     {
-        HandleSdlEvents(running);
+        // sleeps while idle: input, a finished async call or the idle poll wakes it up
+        const auto input{ HandleSdlEvents(running, m_framePacer->GetTimeout()) };
+
+        // the async filesystem calls continue here, before anything is updated
+        executor.ResumeUi();
+
+        // the events of the last frame are applied before the views are rendered again
+        event_bus.Drain();
 
-        m_window->StartFrame();
+        // the views are updated even without a frame, e.g. to notice changes of the watched directories
         Update();
-        Render();
-        m_window->EndFrame();
+
+        const auto render{ m_framePacer->NextFrame(input, IsBusy()) };
+        if (render)
+        {
+            m_window->StartFrame();
+            Render();
+            m_window->EndFrame();
+        }
+
+        IC_PROFILE_END_FRAME(render);
     }
 
     IC_LOG_DEBUG("[Application::Loop()] The application loop has ended.");
@@ -172,3 +239,34 @@ void ic::application::Application::InitRootPaths()
 
     IC_ASSERT(!root_paths.empty(), "[Application::InitRootPaths()] Invalid number of root paths.")
 }
+
+void ic::application::Application::ApplyOperationChanges() const
+{
+    std::vector<operation::Change> changes;
+    m_operationQueue->TakeChanges(changes);
+
+    for (const auto& change : changes)
+    {
+        for (auto* view : { leftView.get(), rightView.get() })
+        {
+            // a watched view picks up the change itself
+            if (!view->IsWatching() && view->currentPath == change.directory)
+            {
+                view->Refresh({ change.name });
+            }
+        }
+    }
+}
+
+bool ic::application::Application::IsBusy() const
+{
+    if (leftView->IsBusy() || rightView->IsBusy() || m_finderWidget->IsIndexing() || event_bus.HasPending())
+    {
+        return true;
+    }
+
+    // a paused job shows no progress
+    return std::ranges::any_of(m_operationQueue->GetOperations(), [](const auto& t_operation) {
+        return t_operation->IsStarted() && !t_operation->IsFinished() && !t_operation->IsPaused();
+    });
+}
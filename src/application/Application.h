@@ -18,19 +18,34 @@
 
 #pragma once
 
-#include <eventpp/eventdispatcher.h>
-#include "event/Event.h"
+#include "event/EventBus.h"
+#include "data/ListingCache.h"
+#include "data/EntryText.h"
+#include "async/Executor.h"
 #include "vendor/ini/ini.h"
 
+namespace ic::data
+{
+    class Prefetcher;
+}
+
+namespace ic::operation
+{
+    class OperationQueue;
+}
+
 namespace ic::widget
 {
     class MainMenuWidget;
     class BottomMenuWidget;
+    class FinderWidget;
+    class OperationsWidget;
 }
 
 namespace ic::application
 {
     class Window;
+    class FramePacer;
 
     class Application
     {
@@ -40,10 +55,17 @@ namespace ic::application
         //-------------------------------------------------
 
         inline static const inih::INIReader INI{ "./config.ini" };
-        inline static eventpp::EventDispatcher<event::IcEventType, void(const event::IcEvent&)> event_dispatcher;
+        inline static event::EventBus event_bus;
+        inline static async::Executor executor;
 
         inline static data::ViewType current_view_type{ data::ViewType::NONE };
         inline static std::set<std::filesystem::path> root_paths;
+        inline static data::ListingCache listing_cache;
+        inline static data::SizeFormat size_format{ data::SizeFormat::HUMAN };
+        inline static data::TimeFormat time_format{ data::TimeFormat::LOCAL };
+        inline static bool natural_sort{ false };
+        inline static bool show_finder{ false };
+        inline static bool show_jobs{ false };
 
         std::unique_ptr<data::View> leftView;
         std::unique_ptr<data::View> rightView;
@@ -61,6 +83,12 @@ namespace ic::application
 
         ~Application() noexcept;
 
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] const FramePacer& GetFramePacer() const { return *m_framePacer; }
+
         //-------------------------------------------------
         // Run
         //-------------------------------------------------
@@ -75,16 +103,23 @@ namespace ic::application
         //-------------------------------------------------
 
         std::unique_ptr<Window> m_window;
+        std::unique_ptr<FramePacer> m_framePacer;
+
+        std::unique_ptr<data::Prefetcher> m_prefetcher;
+
+        std::unique_ptr<operation::OperationQueue> m_operationQueue;
 
         std::unique_ptr<widget::MainMenuWidget> m_mainMenuWidget;
         std::unique_ptr<widget::BottomMenuWidget> m_bottomMenuWidget;
+        std::unique_ptr<widget::FinderWidget> m_finderWidget;
+        std::unique_ptr<widget::OperationsWidget> m_operationsWidget;
 
         //-------------------------------------------------
         // Logic
         //-------------------------------------------------
 
         void Init();
-        void HandleSdlEvents(bool& t_running);
+        [[nodiscard]] bool HandleSdlEvents(bool& t_running, int t_timeout);
         void Update();
         void Render() const;
 
@@ -99,5 +134,18 @@ namespace ic::application
         //-------------------------------------------------
 
         static void InitRootPaths();
+
+        /**
+         * Reads the entries changed by the file operations again
+         * in the views that do not watch their currentPath.
+         */
+        void ApplyOperationChanges() const;
+
+        /**
+         * Checks whether background work is running whose progress is shown.
+         *
+         * @return True if frames have to be rendered without input.
+         */
+        [[nodiscard]] bool IsBusy() const;
     };
 }
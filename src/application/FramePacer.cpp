@@ -0,0 +1,123 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "FramePacer.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::application::FramePacer::FramePacer(const bool t_idle, const int t_maxFps, const int t_busyFps, const std::chrono::milliseconds t_idlePoll)
+    : m_idle{ t_idle }
+    , m_activeInterval{ ToInterval(t_maxFps) }
+    , m_busyInterval{ ToInterval(t_busyFps) }
+    , m_idlePoll{ std::max(t_idlePoll, std::chrono::milliseconds(10)) }
+    , m_activeUntil{ Clock::now() + ACTIVE_PERIOD }
+{
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+int ic::application::FramePacer::GetTimeout() const
+{
+    if (m_state == State::IDLE)
+    {
+        return static_cast<int>(m_idlePoll.count());
+    }
+
+    // wait for the frame cap, but wake up for input; also without idling, so the loop never spins
+    const auto left{ m_lastFrame + GetInterval() - Clock::now() };
+    if (left <= Clock::duration::zero())
+    {
+        return 0;
+    }
+
+    return static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(left).count());
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+bool ic::application::FramePacer::NextFrame(const bool t_input, const bool t_busy)
+{
+    const auto now{ Clock::now() };
+
+    if (t_input)
+    {
+        m_activeUntil = now + ACTIVE_PERIOD;
+    }
+
+    const auto previous{ m_state };
+    if (!m_idle || now < m_activeUntil)
+    {
+        m_state = State::ACTIVE;
+    }
+    else
+    {
+        m_state = t_busy ? State::BUSY : State::IDLE;
+    }
+
+    if (m_state == State::IDLE)
+    {
+        // the results of the work that just finished are shown once
+        if (previous != State::IDLE)
+        {
+            m_lastFrame = now;
+            ++m_stats.busyFrames;
+
+            return true;
+        }
+
+        ++m_stats.idleWakeUps;
+
+        return false;
+    }
+
+    if (now - m_lastFrame < GetInterval())
+    {
+        return false;
+    }
+
+    m_lastFrame = now;
+    ++(m_state == State::ACTIVE ? m_stats.activeFrames : m_stats.busyFrames);
+
+    return true;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+ic::application::FramePacer::Clock::duration ic::application::FramePacer::GetInterval() const
+{
+    return m_state == State::BUSY ? m_busyInterval : m_activeInterval;
+}
+
+ic::application::FramePacer::Clock::duration ic::application::FramePacer::ToInterval(const int t_fps)
+{
+    if (t_fps <= 0)
+    {
+        return Clock::duration::zero();
+    }
+
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / t_fps;
+}
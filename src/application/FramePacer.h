@@ -0,0 +1,134 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace ic::application
+{
+    /**
+     * Decides when a frame is rendered. Without input or background work
+     * the application loop sleeps instead of redrawing every vsync.
+     */
+    class FramePacer
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        using Clock = std::chrono::steady_clock;
+
+        enum class State
+        {
+            ACTIVE, // the user interacts
+            BUSY,   // only the progress of background work is shown
+            IDLE    // nothing changes
+        };
+
+        struct Stats
+        {
+            std::size_t activeFrames{ 0 };
+            std::size_t busyFrames{ 0 };
+            std::size_t idleWakeUps{ 0 };
+        };
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Hover effects and tooltips still need frames after the last input.
+         */
+        static constexpr std::chrono::milliseconds ACTIVE_PERIOD{ 500 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        FramePacer() = delete;
+
+        /**
+         * @param t_idle False to never idle; the frames are still capped by t_maxFps.
+         * @param t_maxFps The frame cap while the user interacts. 0 for none.
+         * @param t_busyFps The frame cap while only background work is running.
+         * @param t_idlePoll How often the watched directories are checked while idle.
+         */
+        FramePacer(bool t_idle, int t_maxFps, int t_busyFps, std::chrono::milliseconds t_idlePoll);
+
+        FramePacer(const FramePacer& t_other) = delete;
+        FramePacer(FramePacer&& t_other) noexcept = delete;
+        FramePacer& operator=(const FramePacer& t_other) = delete;
+        FramePacer& operator=(FramePacer&& t_other) noexcept = delete;
+
+        ~FramePacer() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] State GetState() const { return m_state; }
+        [[nodiscard]] const Stats& GetStats() const { return m_stats; }
+
+        /**
+         * @return How long the loop may wait for SDL events in milliseconds. 0 to not wait.
+         */
+        [[nodiscard]] int GetTimeout() const;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Is called once per loop iteration, after the views were updated.
+         *
+         * @param t_input True if SDL events were received.
+         * @param t_busy True if background work is running whose progress is shown.
+         *
+         * @return True if a frame has to be rendered.
+         */
+        bool NextFrame(bool t_input, bool t_busy);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        bool m_idle;
+        Clock::duration m_activeInterval{ Clock::duration::zero() };
+        Clock::duration m_busyInterval{ Clock::duration::zero() };
+        std::chrono::milliseconds m_idlePoll;
+
+        State m_state{ State::ACTIVE };
+        Clock::time_point m_activeUntil;
+        Clock::time_point m_lastFrame;
+
+        Stats m_stats;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        [[nodiscard]] Clock::duration GetInterval() const;
+        [[nodiscard]] static Clock::duration ToInterval(int t_fps);
+    };
+}
@@ -19,8 +19,13 @@
 #include "Util.h"
 #include "Application.h"
 
-#if defined(_WIN64) && defined(_MSC_VER)
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <unistd.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+#elif defined(_WIN64) && defined(_MSC_VER)
     #define NOMINMAX
+    #include <Windows.h>
     #include <codecvt>
     #include <Aclapi.h>
     #include <ranges>
@@ -35,56 +40,28 @@ bool ic::application::Util::IsRootDirectory(const std::filesystem::path& t_path)
     return Application::root_paths.contains(t_path);
 }
 
-std::string ic::application::Util::ToZeroLead(const std::string& t_time)
-{
-    return std::string(2 - std::min(2, static_cast<int>(t_time.length())), '0') + t_time;
-}
-
-std::string ic::application::Util::LastWriteTimeToStr(const std::filesystem::file_time_type& t_fileTime)
+void ic::application::Util::LowerThreadPriority()
 {
-    std::chrono::time_point<std::chrono::system_clock> ftsys;
-
-#if defined(_WIN64) && defined(_MSC_VER)
-    ftsys = std::chrono::utc_clock::to_sys(std::chrono::file_clock::to_utc(t_fileTime));
-#elif defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
-    ftsys = std::chrono::file_clock::to_sys(t_fileTime);
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    // both apply to the calling thread only
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+
+    static constexpr int IOPRIO_WHO_PROCESS{ 1 };
+    static constexpr int IOPRIO_CLASS_IDLE{ 3 };
+    static constexpr int IOPRIO_CLASS_SHIFT{ 13 };
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+#elif defined(_WIN64) && defined(_MSC_VER)
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
 #endif
-
-    time_t ftt{ std::chrono::system_clock::to_time_t(ftsys) };
-    const auto tminfo{ localtime(&ftt) };
-
-    return ToZeroLead(std::to_string(tminfo->tm_mday)).append(".").append(ToZeroLead(std::to_string(tminfo->tm_mon + 1))).append(".").append(std::to_string(tminfo->tm_year + 1900)).append(" ").append(ToZeroLead(std::to_string(tminfo->tm_hour))).append(":").append(ToZeroLead(std::to_string(tminfo->tm_min)));
-}
-
-std::string ic::application::Util::GetHumanReadableSize(const unsigned long long t_bytes)
-{
-    static constexpr float gb{ 1024.0f * 1024.0f * 1024.0f };
-    static constexpr float mb{ 1024.0f * 1024.0f };
-    static constexpr float kb{ 1024.0f };
-
-    if (auto bytes{ static_cast<float>(t_bytes) }; bytes > gb)
-    {
-        return FloatToString(bytes / gb).append(" Gb ");
-    }
-    else if (bytes > mb)
-    {
-        return FloatToString(bytes / mb).append(" Mb ");
-    }
-    else if (bytes > kb)
-    {
-        return FloatToString(bytes / kb).append(" Kb ");
-    }
-
-    return FloatToString(static_cast<float>(t_bytes)).append(" B ");
 }
 
-std::string ic::application::Util::FloatToString(const float t_val)
+bool ic::application::Util::IsPseudoFileSystem([[maybe_unused]] const std::filesystem::path& t_path)
 {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2) << t_val;
-    std::string result = oss.str();
-
-    return result;
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    return t_path == "/proc" || t_path == "/sys" || t_path == "/dev";
+#else
+    return false;
+#endif
 }
 
 //-------------------------------------------------
@@ -31,10 +31,22 @@ namespace ic::application
         //-------------------------------------------------
 
         [[nodiscard]] static bool IsRootDirectory(const std::filesystem::path& t_path);
-        [[nodiscard]] static std::string ToZeroLead(const std::string& t_time);
-        [[nodiscard]] static std::string LastWriteTimeToStr(const std::filesystem::file_time_type& t_fileTime);
-        [[nodiscard]] static std::string GetHumanReadableSize(unsigned long long t_bytes);
-        [[nodiscard]] static std::string FloatToString(float t_val);
+
+        /**
+         * Lowers the CPU and I/O priority of the calling thread,
+         * so that background work does not compete with the UI.
+         */
+        static void LowerThreadPriority();
+
+        /**
+         * Checks whether a directory is the mount point of a file system like /proc,
+         * whose files are created by the kernel and must not be walked.
+         *
+         * @param t_path The directory.
+         *
+         * @return True if the directory should be skipped by a recursive walk.
+         */
+        [[nodiscard]] static bool IsPseudoFileSystem(const std::filesystem::path& t_path);
 
         //-------------------------------------------------
         // Win64
@@ -18,6 +18,7 @@
 
 #include "Window.h"
 #include "Log.h"
+#include "IcProfile.h"
 #include "IcException.h"
 #include "vendor/imgui/imgui_impl_opengl3.h"
 #include "vendor/imgui/imgui_impl_opengl3_loader.h"
@@ -51,6 +52,8 @@ ic::application::Window::~Window() noexcept
 
 void ic::application::Window::StartFrame() const
 {
+    IC_PROFILE_SCOPE("Window::StartFrame");
+
     glClear(GL_COLOR_BUFFER_BIT);
 
     ImGui_ImplOpenGL3_NewFrame();
@@ -60,11 +63,20 @@ void ic::application::Window::StartFrame() const
 
 void ic::application::Window::EndFrame() const
 {
+    IC_PROFILE_SCOPE("Window::EndFrame");
+
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     SDL_GL_SwapWindow(sdlWindow);
 }
 
+void ic::application::Window::WakeUp()
+{
+    SDL_Event event{};
+    event.type = SDL_USEREVENT;
+    SDL_PushEvent(&event);
+}
+
 void ic::application::Window::OnSdlEvent(const SDL_Event* t_event)
 {
     if (t_event->type == SDL_WINDOWEVENT && t_event->window.event == SDL_WINDOWEVENT_RESIZED)
@@ -57,6 +57,11 @@ namespace ic::application
         void EndFrame() const;
         void OnSdlEvent(const SDL_Event* t_event);
 
+        /**
+         * Interrupts the wait for SDL events. Can be called from any thread.
+         */
+        static void WakeUp();
+
     protected:
 
     private:
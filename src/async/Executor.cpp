@@ -0,0 +1,136 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "Executor.h"
+#include "Log.h"
+#include "IcProfile.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+// a static member of the Application; nothing is logged, as the logger may not exist
+
+ic::async::Executor::~Executor() noexcept
+{
+    Stop();
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::async::Executor::Start(const std::size_t t_workers)
+{
+    IC_LOG_DEBUG("[Executor::Start()] Start {} I/O threads.", t_workers);
+
+    for (std::size_t i{ 0 }; i < t_workers; ++i)
+    {
+        m_workers.emplace_back([this](const std::stop_token& t_stopToken) { Work(t_stopToken); });
+    }
+}
+
+void ic::async::Executor::SetWakeUp(std::function<void()> t_wakeUp)
+{
+    m_wakeUp = std::move(t_wakeUp);
+}
+
+void ic::async::Executor::Stop()
+{
+    m_workers.clear();
+
+    std::scoped_lock lock{ m_mutex };
+    m_jobs.clear();
+    m_uiHandles.clear();
+}
+
+void ic::async::Executor::Post(std::function<void()> t_job)
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        m_jobs.push_back(std::move(t_job));
+    }
+
+    m_condition.notify_one();
+}
+
+void ic::async::Executor::PostToUi(const std::coroutine_handle<> t_handle)
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        m_uiHandles.push_back(t_handle);
+    }
+
+    if (m_wakeUp)
+    {
+        m_wakeUp();
+    }
+}
+
+void ic::async::Executor::ResumeUi()
+{
+    IC_PROFILE_SCOPE("Executor::ResumeUi");
+
+    std::vector<std::coroutine_handle<>> handles;
+    {
+        std::scoped_lock lock{ m_mutex };
+        handles.swap(m_uiHandles);
+    }
+
+    // a resumed coroutine may post again; that one is resumed in the next frame
+    for (const auto handle : handles)
+    {
+        handle.resume();
+    }
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::async::Executor::Work(const std::stop_token& t_stopToken)
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock lock{ m_mutex };
+            if (!m_condition.wait(lock, t_stopToken, [this] { return !m_jobs.empty(); }))
+            {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        // the job must not end the program; Offload passes its exceptions on to the awaiting task
+        try
+        {
+            job();
+        }
+        catch (const std::exception& e)
+        {
+            IC_LOG_ERROR("[Executor::Work()] A job ended with an exception: {}", e.what());
+        }
+        catch (...)
+        {
+            IC_LOG_ERROR("[Executor::Work()] A job ended with an unknown exception.");
+        }
+    }
+}
@@ -0,0 +1,122 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace ic::async
+{
+    /**
+     * Runs blocking filesystem calls on a few I/O threads
+     * and resumes the waiting coroutines on the UI thread.
+     */
+    class Executor
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::size_t WORKERS{ 2 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Executor() = default;
+
+        Executor(const Executor& t_other) = delete;
+        Executor(Executor&& t_other) noexcept = delete;
+        Executor& operator=(const Executor& t_other) = delete;
+        Executor& operator=(Executor&& t_other) noexcept = delete;
+
+        ~Executor() noexcept;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Starts the I/O threads.
+         *
+         * @param t_workers The number of threads.
+         */
+        void Start(std::size_t t_workers = WORKERS);
+
+        /**
+         * Sets a function that is called whenever a coroutine is posted to the UI thread,
+         * e.g. to wake up an idle application loop. Must be set before Start().
+         *
+         * @param t_wakeUp The function. It is called from the I/O threads.
+         */
+        void SetWakeUp(std::function<void()> t_wakeUp);
+
+        /**
+         * Stops the I/O threads. Jobs not yet started are dropped,
+         * so the coroutines waiting for them are never resumed.
+         */
+        void Stop();
+
+        /**
+         * Runs a job on an I/O thread. An exception thrown by the job is logged.
+         *
+         * @param t_job The job.
+         */
+        void Post(std::function<void()> t_job);
+
+        /**
+         * Resumes a coroutine on the UI thread. Can be called from any thread.
+         *
+         * @param t_handle The coroutine.
+         */
+        void PostToUi(std::coroutine_handle<> t_handle);
+
+        /**
+         * Resumes the coroutines posted to the UI thread. Must be called from the UI thread.
+         */
+        void ResumeUi();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_condition;
+        std::deque<std::function<void()>> m_jobs;
+        std::vector<std::coroutine_handle<>> m_uiHandles;
+        std::function<void()> m_wakeUp;
+
+        std::vector<std::jthread> m_workers;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void Work(const std::stop_token& t_stopToken);
+    };
+}
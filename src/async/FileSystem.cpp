@@ -0,0 +1,121 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <fstream>
+#include "FileSystem.h"
+#include "Offload.h"
+#include "IcProfile.h"
+
+// The parameters are taken by value, because they must live as long as the coroutine.
+
+ic::async::Task<ic::async::Result<ic::data::Scanner::Batch>> ic::async::Scan(std::filesystem::path t_path, std::size_t t_maxEntries)
+{
+    co_return co_await Offload([&t_path, t_maxEntries] {
+        Result<data::Scanner::Batch> result;
+        if (!data::Scanner::ReadAll(
+            {},
+            t_path,
+            application::Application::INI.Get<bool>("scan", "io_uring", true),
+            t_maxEntries,
+            result.value
+        ))
+        {
+            result.error = std::make_error_code(std::errc::io_error);
+        }
+
+        return result;
+    });
+}
+
+ic::async::Task<ic::async::Result<ic::async::Stat>> ic::async::GetStat(std::filesystem::path t_path)
+{
+    co_return co_await Offload([&t_path] {
+        Result<Stat> result;
+        result.value.status = IC_PROFILE_FS(LSTAT, "async::GetStat", std::filesystem::symlink_status(t_path, result.error));
+        if (!result.error && std::filesystem::is_regular_file(result.value.status))
+        {
+            result.value.size = IC_PROFILE_FS(STAT, "async::GetStat", std::filesystem::file_size(t_path, result.error));
+        }
+        if (!result.error)
+        {
+            result.value.lastWriteTime = IC_PROFILE_FS(STAT, "async::GetStat", std::filesystem::last_write_time(t_path, result.error));
+        }
+
+        return result;
+    });
+}
+
+ic::async::Task<std::error_code> ic::async::MakeDirectory(std::filesystem::path t_path)
+{
+    co_return co_await Offload([&t_path] {
+        std::error_code ec;
+        if (!std::filesystem::create_directory(t_path, ec) && !ec)
+        {
+            ec = std::make_error_code(std::errc::file_exists);
+        }
+
+        return ec;
+    });
+}
+
+ic::async::Task<std::error_code> ic::async::Rename(std::filesystem::path t_from, std::filesystem::path t_to)
+{
+    co_return co_await Offload([&t_from, &t_to] {
+        std::error_code ec;
+        std::filesystem::rename(t_from, t_to, ec);
+
+        return ec;
+    });
+}
+
+ic::async::Task<std::error_code> ic::async::Remove(std::filesystem::path t_path)
+{
+    co_return co_await Offload([&t_path] {
+        std::error_code ec;
+        if (!std::filesystem::remove(t_path, ec) && !ec)
+        {
+            ec = std::make_error_code(std::errc::no_such_file_or_directory);
+        }
+
+        return ec;
+    });
+}
+
+ic::async::Task<ic::async::Result<std::string>> ic::async::Read(std::filesystem::path t_path, std::size_t t_maxBytes)
+{
+    co_return co_await Offload([&t_path, t_maxBytes] {
+        Result<std::string> result;
+
+        std::ifstream file{ t_path, std::ios::binary };
+        if (!file)
+        {
+            result.error = std::make_error_code(std::errc::no_such_file_or_directory);
+            return result;
+        }
+
+        result.value.resize(t_maxBytes);
+        file.read(result.value.data(), static_cast<std::streamsize>(t_maxBytes));
+        if (file.bad())
+        {
+            result.error = std::make_error_code(std::errc::io_error);
+        }
+        result.value.resize(static_cast<std::size_t>(file.gcount()));
+
+        return result;
+    });
+}
@@ -0,0 +1,94 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <cstdint>
+#include "Task.h"
+#include "data/Scanner.h"
+
+namespace ic::async
+{
+    //-------------------------------------------------
+    // Types
+    //-------------------------------------------------
+
+    /**
+     * A value or the error that prevented it.
+     */
+    template <typename T>
+    struct Result
+    {
+        T value{};
+        std::error_code error;
+
+        explicit operator bool() const { return !error; }
+    };
+
+    struct Stat
+    {
+        std::filesystem::file_status status;
+        std::uint64_t size{ 0 };
+        std::filesystem::file_time_type lastWriteTime;
+    };
+
+    //-------------------------------------------------
+    // Filesystem
+    //-------------------------------------------------
+
+    // Each call runs on an I/O thread; the awaiting coroutine continues on the UI thread.
+
+    /**
+     * Reads the entries of a directory.
+     *
+     * @param t_path The directory.
+     * @param t_maxEntries Reading stops with an error if the directory has more entries.
+     */
+    Task<Result<data::Scanner::Batch>> Scan(std::filesystem::path t_path, std::size_t t_maxEntries);
+
+    /**
+     * Reads the metadata of an entry; symlinks are not followed.
+     */
+    Task<Result<Stat>> GetStat(std::filesystem::path t_path);
+
+    /**
+     * Creates a directory; fails if the path exists.
+     */
+    Task<std::error_code> MakeDirectory(std::filesystem::path t_path);
+
+    /**
+     * Renames an entry.
+     */
+    Task<std::error_code> Rename(std::filesystem::path t_from, std::filesystem::path t_to);
+
+    /**
+     * Removes a file, a symlink or an empty directory.
+     */
+    Task<std::error_code> Remove(std::filesystem::path t_path);
+
+    /**
+     * Reads the beginning of a file.
+     *
+     * @param t_path The file.
+     * @param t_maxBytes The maximum number of bytes to read.
+     */
+    Task<Result<std::string>> Read(std::filesystem::path t_path, std::size_t t_maxBytes);
+}
@@ -0,0 +1,106 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include "application/Application.h"
+
+namespace ic::async
+{
+    /**
+     * Awaits a function that runs on an I/O thread of the Application::executor.
+     * The awaiting coroutine continues on the UI thread with the result,
+     * or the exception thrown by the function is rethrown there.
+     */
+    template <typename Function>
+    class Offload
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        using Result = std::invoke_result_t<Function&>;
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Offload() = delete;
+
+        explicit Offload(Function t_function)
+            : m_function{ std::move(t_function) }
+        {
+        }
+
+        Offload(const Offload& t_other) = delete;
+        Offload(Offload&& t_other) noexcept = delete;
+        Offload& operator=(const Offload& t_other) = delete;
+        Offload& operator=(Offload&& t_other) noexcept = delete;
+
+        ~Offload() noexcept = default;
+
+        //-------------------------------------------------
+        // Awaiter
+        //-------------------------------------------------
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(const std::coroutine_handle<> t_handle)
+        {
+            // the awaiter lives in the suspended coroutine frame until it is resumed
+            application::Application::executor.Post([this, t_handle] {
+                try
+                {
+                    m_result.emplace(m_function());
+                }
+                catch (...)
+                {
+                    m_exception = std::current_exception();
+                }
+
+                application::Application::executor.PostToUi(t_handle);
+            });
+        }
+
+        Result await_resume()
+        {
+            if (m_exception)
+            {
+                std::rethrow_exception(m_exception);
+            }
+
+            return std::move(*m_result);
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        Function m_function;
+        std::optional<Result> m_result;
+        std::exception_ptr m_exception;
+    };
+}
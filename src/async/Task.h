@@ -0,0 +1,193 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include "Log.h"
+
+namespace ic::async
+{
+    /**
+     * Stores the result of a Task.
+     */
+    template <typename T>
+    struct TaskResult
+    {
+        std::optional<T> value;
+
+        void return_value(T t_value) { value.emplace(std::move(t_value)); }
+        T Take() { return std::move(*value); }
+    };
+
+    template <>
+    struct TaskResult<void>
+    {
+        void return_void() noexcept {}
+        void Take() noexcept {}
+    };
+
+    /**
+     * A coroutine that starts when it is awaited and then resumes the awaiting coroutine.
+     * A task that nobody awaits is started with Spawn().
+     */
+    template <typename T = void>
+    class Task
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct promise_type : TaskResult<T>
+        {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+            bool detached{ false };
+
+            Task get_return_object() { return Task{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            auto final_suspend() const noexcept { return FinalAwaiter{}; }
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Task() = delete;
+
+        Task(const Task& t_other) = delete;
+
+        Task(Task&& t_other) noexcept
+            : m_handle{ std::exchange(t_other.m_handle, {}) }
+        {
+        }
+
+        Task& operator=(const Task& t_other) = delete;
+        Task& operator=(Task&& t_other) noexcept = delete;
+
+        ~Task() noexcept
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+        }
+
+        //-------------------------------------------------
+        // Awaiter
+        //-------------------------------------------------
+
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(const std::coroutine_handle<> t_continuation) noexcept
+        {
+            m_handle.promise().continuation = t_continuation;
+
+            return m_handle;
+        }
+
+        T await_resume()
+        {
+            if (m_handle.promise().exception)
+            {
+                std::rethrow_exception(m_handle.promise().exception);
+            }
+
+            return m_handle.promise().Take();
+        }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Starts the task without waiting for it; the task frees itself when it has finished.
+         */
+        void Detach()
+        {
+            auto handle{ std::exchange(m_handle, {}) };
+            handle.promise().detached = true;
+            handle.resume();
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(const std::coroutine_handle<promise_type> t_handle) const noexcept
+            {
+                auto& promise{ t_handle.promise() };
+                if (promise.continuation)
+                {
+                    return promise.continuation;
+                }
+
+                if (promise.detached)
+                {
+                    if (promise.exception)
+                    {
+                        IC_LOG_ERROR("[Task::FinalAwaiter::await_suspend()] A detached task ended with an exception.");
+                    }
+
+                    t_handle.destroy();
+                }
+
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        std::coroutine_handle<promise_type> m_handle;
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        explicit Task(const std::coroutine_handle<promise_type> t_handle)
+            : m_handle{ t_handle }
+        {
+        }
+    };
+
+    /**
+     * Starts a task from code that is not a coroutine, e.g. a widget.
+     *
+     * @param t_task The task.
+     */
+    inline void Spawn(Task<> t_task)
+    {
+        t_task.Detach();
+    }
+}
@@ -0,0 +1,225 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "Collation.h"
+
+//-------------------------------------------------
+// Keys
+//-------------------------------------------------
+
+std::string ic::data::Collation::FoldCase(const std::string_view t_utf8)
+{
+    std::string result;
+    result.reserve(t_utf8.size());
+
+    const auto size{ t_utf8.size() };
+    std::size_t i{ 0 };
+    while (i < size)
+    {
+        const auto c0{ static_cast<unsigned char>(t_utf8[i]) };
+
+        // ASCII
+        if (c0 < 0x80)
+        {
+            result.push_back(c0 >= 'A' && c0 <= 'Z' ? static_cast<char>(c0 + 0x20) : static_cast<char>(c0));
+            ++i;
+            continue;
+        }
+
+        // decode a multibyte sequence
+        std::size_t len{ 0 };
+        char32_t cp{ 0 };
+        if ((c0 & 0xE0) == 0xC0)
+        {
+            len = 2;
+            cp = c0 & 0x1F;
+        }
+        else if ((c0 & 0xF0) == 0xE0)
+        {
+            len = 3;
+            cp = c0 & 0x0F;
+        }
+        else if ((c0 & 0xF8) == 0xF0)
+        {
+            len = 4;
+            cp = c0 & 0x07;
+        }
+
+        auto valid{ len != 0 && i + len <= size };
+        for (std::size_t k{ 1 }; valid && k < len; ++k)
+        {
+            const auto ck{ static_cast<unsigned char>(t_utf8[i + k]) };
+            valid = (ck & 0xC0) == 0x80;
+            cp = (cp << 6) | (ck & 0x3F);
+        }
+
+        if (!valid)
+        {
+            result.push_back(static_cast<char>(c0));
+            ++i;
+            continue;
+        }
+
+        AppendUtf8(result, FoldCodePoint(cp));
+        i += len;
+    }
+
+    return result;
+}
+
+std::string ic::data::Collation::NaturalKey(const std::string_view t_key)
+{
+    static constexpr std::size_t MAX_DIGITS{ 254 };
+
+    const auto isDigit{ [](const char t_c) { return t_c >= '0' && t_c <= '9'; } };
+
+    std::string result;
+    result.reserve(t_key.size() + 8);
+
+    const auto size{ t_key.size() };
+    std::size_t i{ 0 };
+    while (i < size)
+    {
+        if (!isDigit(t_key[i]))
+        {
+            result.push_back(t_key[i++]);
+            continue;
+        }
+
+        const auto first{ i };
+        while (i < size && isDigit(t_key[i]))
+        {
+            ++i;
+        }
+
+        // leading zeros do not change the value
+        auto digits{ t_key.substr(first, i - first) };
+        digits.remove_prefix(std::min(digits.find_first_not_of('0'), digits.size()));
+
+        // the marker keeps the order of digits relative to other characters
+        result.push_back('0');
+        result.push_back(static_cast<char>(std::min(digits.size(), MAX_DIGITS) + 1));
+        result.append(digits);
+    }
+
+    return result;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+char32_t ic::data::Collation::FoldCodePoint(const char32_t t_cp)
+{
+    // Latin-1 Supplement
+    if (t_cp >= 0x00C0 && t_cp <= 0x00DE && t_cp != 0x00D7)
+    {
+        return t_cp + 0x20;
+    }
+
+    // Latin Extended-A
+    if ((t_cp >= 0x0100 && t_cp <= 0x012F) || (t_cp >= 0x0132 && t_cp <= 0x0137) || (t_cp >= 0x014A && t_cp <= 0x0177))
+    {
+        return t_cp | 1;
+    }
+    if ((t_cp >= 0x0139 && t_cp <= 0x0148) || (t_cp >= 0x0179 && t_cp <= 0x017E))
+    {
+        return (t_cp & 1) ? t_cp + 1 : t_cp;
+    }
+    if (t_cp == 0x0178)
+    {
+        return 0x00FF;
+    }
+
+    // Greek
+    if ((t_cp >= 0x0391 && t_cp <= 0x03A9 && t_cp != 0x03A2))
+    {
+        return t_cp + 0x20;
+    }
+    if (t_cp == 0x0386)
+    {
+        return 0x03AC;
+    }
+    if (t_cp >= 0x0388 && t_cp <= 0x038A)
+    {
+        return t_cp + 0x25;
+    }
+    if (t_cp == 0x038C)
+    {
+        return 0x03CC;
+    }
+    if (t_cp == 0x038E || t_cp == 0x038F)
+    {
+        return t_cp + 0x3F;
+    }
+
+    // Cyrillic
+    if (t_cp >= 0x0410 && t_cp <= 0x042F)
+    {
+        return t_cp + 0x20;
+    }
+    if (t_cp >= 0x0400 && t_cp <= 0x040F)
+    {
+        return t_cp + 0x50;
+    }
+    if ((t_cp >= 0x0460 && t_cp <= 0x0481) || (t_cp >= 0x048A && t_cp <= 0x04BF))
+    {
+        return t_cp | 1;
+    }
+
+    // Latin Extended Additional
+    if ((t_cp >= 0x1E00 && t_cp <= 0x1E95) || (t_cp >= 0x1EA0 && t_cp <= 0x1EFF))
+    {
+        return t_cp | 1;
+    }
+
+    // Fullwidth Latin
+    if (t_cp >= 0xFF21 && t_cp <= 0xFF3A)
+    {
+        return t_cp + 0x20;
+    }
+
+    return t_cp;
+}
+
+void ic::data::Collation::AppendUtf8(std::string& t_out, const char32_t t_cp)
+{
+    if (t_cp < 0x80)
+    {
+        t_out.push_back(static_cast<char>(t_cp));
+    }
+    else if (t_cp < 0x800)
+    {
+        t_out.push_back(static_cast<char>(0xC0 | (t_cp >> 6)));
+        t_out.push_back(static_cast<char>(0x80 | (t_cp & 0x3F)));
+    }
+    else if (t_cp < 0x10000)
+    {
+        t_out.push_back(static_cast<char>(0xE0 | (t_cp >> 12)));
+        t_out.push_back(static_cast<char>(0x80 | ((t_cp >> 6) & 0x3F)));
+        t_out.push_back(static_cast<char>(0x80 | (t_cp & 0x3F)));
+    }
+    else
+    {
+        t_out.push_back(static_cast<char>(0xF0 | (t_cp >> 18)));
+        t_out.push_back(static_cast<char>(0x80 | ((t_cp >> 12) & 0x3F)));
+        t_out.push_back(static_cast<char>(0x80 | ((t_cp >> 6) & 0x3F)));
+        t_out.push_back(static_cast<char>(0x80 | (t_cp & 0x3F)));
+    }
+}
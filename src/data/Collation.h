@@ -0,0 +1,65 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace ic::data
+{
+    class Collation
+    {
+    public:
+        //-------------------------------------------------
+        // Keys
+        //-------------------------------------------------
+
+        /**
+         * Creates a case-folded copy of an UTF-8 string.
+         * Simple case folding is done for ASCII, Latin, Greek and Cyrillic letters.
+         * Invalid UTF-8 sequences are copied unchanged.
+         *
+         * @param t_utf8 An UTF-8 string.
+         *
+         * @return The case-folded string.
+         */
+        [[nodiscard]] static std::string FoldCase(std::string_view t_utf8);
+
+        /**
+         * Creates a key whose byte-wise order is the natural order, e.g. "log2" before "log10".
+         * Each run of digits is replaced by a '0', the number of its significant digits
+         * plus one and the significant digits. Comparing the keys never parses numbers.
+         *
+         * @param t_key A case-folded name.
+         *
+         * @return The natural key.
+         */
+        [[nodiscard]] static std::string NaturalKey(std::string_view t_key);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        [[nodiscard]] static char32_t FoldCodePoint(char32_t t_cp);
+        static void AppendUtf8(std::string& t_out, char32_t t_cp);
+    };
+}
@@ -18,31 +18,325 @@
 
 #pragma once
 
-#include <filesystem>
+#include <cstdint>
 #include <algorithm>
+#include <string>
+#include <string_view>
+#include "Entry.h"
 
 namespace ic::data
 {
-    struct PathComparator
+    enum class SortKey
     {
-        bool operator()(const std::filesystem::path& t_a, const std::filesystem::path& t_b) const
+        NAME, EXTENSION, SIZE, TIME
+    };
+
+    struct SortSpec
+    {
+        SortKey key{ SortKey::NAME };
+        bool descending{ false };
+
+        /**
+         * Names are compared by their natural key, so numbers are in numerical order.
+         */
+        bool natural{ false };
+
+        bool operator==(const SortSpec& t_other) const = default;
+    };
+
+    /**
+     * Helpers for the comparators below.
+     *
+     * Prefix() splits the sort order into 64 bit integers: entries are ordered
+     * by the prefix of level 0, then level 1 and so on. Levels() returns the
+     * number of levels of an entry. The prefixes are stored with the rows,
+     * so that most comparisons need no access to the entries at all.
+     * The highest bit of level 0 puts the directories first.
+     *
+     * Natural selects the key names are compared by: the naturalKey or the sortKey.
+     */
+    template <bool Natural>
+    struct ComparatorBase
+    {
+        static constexpr std::uint64_t FILE_BIT{ 1ull << 63 };
+
+        static std::uint64_t DirectoryBit(const Entry& t_entry)
         {
-            if (std::filesystem::is_directory(t_a) && !std::filesystem::is_directory(t_b))
+            return t_entry.IsDirectory() ? 0 : FILE_BIT;
+        }
+
+        /**
+         * Packs the bytes of a string key: 7 bytes on level 0, 8 bytes on each further level.
+         * The key is t_head, followed by a zero byte and t_tail if t_tail is not empty.
+         */
+        static std::uint64_t KeyPrefix(const std::string_view t_head, const std::string_view t_tail, const std::size_t t_level)
+        {
+            const auto offset{ t_level == 0 ? 0 : 7 + (t_level - 1) * 8 };
+            const auto bytes{ t_level == 0 ? std::size_t{ 7 } : std::size_t{ 8 } };
+
+            std::uint64_t prefix{ 0 };
+            for (std::size_t i{ 0 }; i < bytes; ++i)
             {
-                return true;
+                const auto pos{ offset + i };
+
+                unsigned char byte{ 0 };
+                if (pos < t_head.size())
+                {
+                    byte = static_cast<unsigned char>(t_head[pos]);
+                }
+                else if (pos > t_head.size() && pos - t_head.size() - 1 < t_tail.size())
+                {
+                    byte = static_cast<unsigned char>(t_tail[pos - t_head.size() - 1]);
+                }
+                else if (pos > t_head.size())
+                {
+                    break;
+                }
+
+                prefix |= static_cast<std::uint64_t>(byte) << ((bytes - 1 - i) * 8);
             }
-            else if (!std::filesystem::is_directory(t_a) && std::filesystem::is_directory(t_b))
+
+            return prefix;
+        }
+
+        static std::size_t KeyLevels(const std::string_view t_head, const std::string_view t_tail)
+        {
+            const auto length{ t_head.size() + (t_tail.empty() ? 0 : 1 + t_tail.size()) };
+
+            return length <= 7 ? 1 : 2 + (length - 8) / 8;
+        }
+
+        static const std::string& NameKey(const Entry& t_entry)
+        {
+            if constexpr (Natural)
+            {
+                return t_entry.naturalKey;
+            }
+            else
             {
-                return false;
+                return t_entry.sortKey;
             }
+        }
+
+        static bool NameLess(const Entry& t_a, const Entry& t_b)
+        {
+            if (NameKey(t_a) != NameKey(t_b))
+            {
+                return NameKey(t_a) < NameKey(t_b);
+            }
+
+            return t_a.name < t_b.name;
+        }
+    };
 
-            // Both are either directories or files.
-            std::string a = t_a.string();
-            std::string b = t_b.string();
-            std::transform(a.begin(), a.end(), a.begin(), [](unsigned char c){ return std::tolower(c); });
-            std::transform(b.begin(), b.end(), b.begin(), [](unsigned char c){ return std::tolower(c); });
+    /**
+     * Directories first, then by the case-folded name.
+     */
+    template <bool Natural = false>
+    struct NameComparator : ComparatorBase<Natural>
+    {
+        using Base = ComparatorBase<Natural>;
+
+        static std::uint64_t Prefix(const Entry& t_entry, const std::size_t t_level)
+        {
+            const auto prefix{ Base::KeyPrefix(Base::NameKey(t_entry), {}, t_level) };
 
-            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+            return t_level == 0 ? Base::DirectoryBit(t_entry) | prefix : prefix;
+        }
+
+        static std::size_t Levels(const Entry& t_entry)
+        {
+            return Base::KeyLevels(Base::NameKey(t_entry), {});
+        }
+
+        bool operator()(const Entry& t_a, const Entry& t_b) const
+        {
+            if (t_a.IsDirectory() != t_b.IsDirectory())
+            {
+                return t_a.IsDirectory();
+            }
+
+            return Base::NameLess(t_a, t_b);
         }
     };
+
+    /**
+     * Directories first, then files by extension and name. Directories are ordered by name.
+     */
+    template <bool Natural = false>
+    struct ExtensionComparator : ComparatorBase<Natural>
+    {
+        using Base = ComparatorBase<Natural>;
+
+        static std::string_view Extension(const Entry& t_entry)
+        {
+            return t_entry.IsDirectory() ? std::string_view() : Entry::GetExtension(t_entry.sortKey);
+        }
+
+        static std::uint64_t Prefix(const Entry& t_entry, const std::size_t t_level)
+        {
+            const auto prefix{ Base::KeyPrefix(Extension(t_entry), Base::NameKey(t_entry), t_level) };
+
+            return t_level == 0 ? Base::DirectoryBit(t_entry) | prefix : prefix;
+        }
+
+        static std::size_t Levels(const Entry& t_entry)
+        {
+            return Base::KeyLevels(Extension(t_entry), Base::NameKey(t_entry));
+        }
+
+        bool operator()(const Entry& t_a, const Entry& t_b) const
+        {
+            if (t_a.IsDirectory() != t_b.IsDirectory())
+            {
+                return t_a.IsDirectory();
+            }
+
+            if (const auto a{ Extension(t_a) }, b{ Extension(t_b) }; a != b)
+            {
+                return a < b;
+            }
+
+            return Base::NameLess(t_a, t_b);
+        }
+    };
+
+    /**
+     * Directories first, then files by size and name. Directories are ordered by name.
+     */
+    template <bool Natural = false>
+    struct SizeComparator : ComparatorBase<Natural>
+    {
+        using Base = ComparatorBase<Natural>;
+
+        static std::uint64_t Size(const Entry& t_entry)
+        {
+            return t_entry.IsDirectory() ? 0 : std::min<std::uint64_t>(t_entry.size, Base::FILE_BIT - 1);
+        }
+
+        static std::uint64_t Prefix(const Entry& t_entry, const std::size_t t_level)
+        {
+            return t_level == 0 ? Base::DirectoryBit(t_entry) | Size(t_entry) : Base::KeyPrefix(Base::NameKey(t_entry), {}, t_level - 1);
+        }
+
+        static std::size_t Levels(const Entry& t_entry)
+        {
+            return 1 + Base::KeyLevels(Base::NameKey(t_entry), {});
+        }
+
+        bool operator()(const Entry& t_a, const Entry& t_b) const
+        {
+            if (t_a.IsDirectory() != t_b.IsDirectory())
+            {
+                return t_a.IsDirectory();
+            }
+
+            if (const auto a{ Size(t_a) }, b{ Size(t_b) }; a != b)
+            {
+                return a < b;
+            }
+
+            return Base::NameLess(t_a, t_b);
+        }
+    };
+
+    /**
+     * Directories first, then by modification time and name.
+     */
+    template <bool Natural = false>
+    struct TimeComparator : ComparatorBase<Natural>
+    {
+        using Base = ComparatorBase<Natural>;
+
+        static std::uint64_t Prefix(const Entry& t_entry, const std::size_t t_level)
+        {
+            if (t_level > 1)
+            {
+                return Base::KeyPrefix(Base::NameKey(t_entry), {}, t_level - 2);
+            }
+
+            // signed to unsigned order
+            const auto ticks{ static_cast<std::uint64_t>(t_entry.lastWriteTime.time_since_epoch().count()) ^ Base::FILE_BIT };
+
+            // the lowest bit makes room for the directory bit and is compared on level 1
+            return t_level == 0 ? Base::DirectoryBit(t_entry) | (ticks >> 1) : ticks & 1;
+        }
+
+        static std::size_t Levels(const Entry& t_entry)
+        {
+            return 2 + Base::KeyLevels(Base::NameKey(t_entry), {});
+        }
+
+        bool operator()(const Entry& t_a, const Entry& t_b) const
+        {
+            if (t_a.IsDirectory() != t_b.IsDirectory())
+            {
+                return t_a.IsDirectory();
+            }
+
+            if (t_a.lastWriteTime != t_b.lastWriteTime)
+            {
+                return t_a.lastWriteTime < t_b.lastWriteTime;
+            }
+
+            return Base::NameLess(t_a, t_b);
+        }
+    };
+
+    /**
+     * Reverses the order of Compare, but the directories stay first.
+     * Inverting every prefix except the directory bit reverses the order of the prefixes.
+     */
+    template <typename Compare>
+    struct Descending : ComparatorBase<false>
+    {
+        static std::uint64_t Prefix(const Entry& t_entry, const std::size_t t_level)
+        {
+            const auto prefix{ Compare::Prefix(t_entry, t_level) };
+
+            return t_level == 0 ? (prefix & FILE_BIT) | (~prefix & ~FILE_BIT) : ~prefix;
+        }
+
+        static std::size_t Levels(const Entry& t_entry)
+        {
+            return Compare::Levels(t_entry);
+        }
+
+        bool operator()(const Entry& t_a, const Entry& t_b) const
+        {
+            if (t_a.IsDirectory() != t_b.IsDirectory())
+            {
+                return t_a.IsDirectory();
+            }
+
+            return Compare()(t_b, t_a);
+        }
+    };
+
+    /**
+     * Calls t_function with the comparator of the given sort spec,
+     * so that the sort algorithms are instantiated for each comparator.
+     *
+     * @param t_spec The sort spec.
+     * @param t_function A generic callable taking a comparator.
+     */
+    template <typename Function>
+    decltype(auto) WithComparator(const SortSpec& t_spec, Function&& t_function)
+    {
+        const auto order{ [&]<typename Compare>(Compare) -> decltype(auto) {
+            return t_spec.descending ? t_function(Descending<Compare>()) : t_function(Compare());
+        } };
+
+        const auto key{ [&]<bool Natural>() -> decltype(auto) {
+            switch (t_spec.key)
+            {
+                case SortKey::EXTENSION: return order(ExtensionComparator<Natural>());
+                case SortKey::SIZE: return order(SizeComparator<Natural>());
+                case SortKey::TIME: return order(TimeComparator<Natural>());
+                default: return order(NameComparator<Natural>());
+            }
+        } };
+
+        return t_spec.natural ? key.template operator()<true>() : key.template operator()<false>();
+    }
 }
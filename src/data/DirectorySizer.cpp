@@ -0,0 +1,347 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "DirectorySizer.h"
+#include "application/Util.h"
+#include "Log.h"
+#include "IcProfile.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include "GetdentsReader.h"
+#endif
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::DirectorySizer::DirectorySizer()
+{
+    IC_LOG_DEBUG("[DirectorySizer::DirectorySizer()] Create DirectorySizer.");
+}
+
+ic::data::DirectorySizer::~DirectorySizer() noexcept
+{
+    IC_LOG_DEBUG("[DirectorySizer::~DirectorySizer()] Destruct DirectorySizer.");
+
+    // the jthread destructors request a stop and join
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool ic::data::DirectorySizer::IsRunning() const
+{
+    return std::ranges::any_of(m_jobs, [](const Job& t_job) {
+        return !t_job.state->finished && !t_job.thread.get_stop_token().stop_requested();
+    });
+}
+
+std::optional<ic::data::DirectorySizer::Totals> ic::data::DirectorySizer::Get(const std::filesystem::path& t_path) const
+{
+    const auto it{ m_results.find(t_path.native()) };
+    if (it == m_results.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto& total{ it->second.state->totals[it->second.total] };
+
+    return Totals{ total.apparent, total.allocated, total.files, total.directories, total.finished };
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::DirectorySizer::Start(std::vector<std::filesystem::path> t_directories)
+{
+    Cancel();
+
+    if (t_directories.empty())
+    {
+        return;
+    }
+
+    IC_LOG_DEBUG("[DirectorySizer::Start()] Compute the sizes of {} directories.", t_directories.size());
+
+    auto state{ std::make_shared<State>() };
+    state->directories = std::move(t_directories);
+    state->totals = std::make_unique<Total[]>(state->directories.size());
+
+    for (std::size_t i{ 0 }; i < state->directories.size(); ++i)
+    {
+        m_results.insert_or_assign(state->directories[i].native(), Result{ state, i });
+    }
+
+    std::jthread thread{ [state](const std::stop_token& t_stopToken) {
+        Run(t_stopToken, *state);
+    } };
+    m_jobs.push_back({ std::move(state), std::move(thread) });
+}
+
+void ic::data::DirectorySizer::Cancel()
+{
+    for (auto& job : m_jobs)
+    {
+        job.thread.request_stop();
+    }
+
+    std::erase_if(m_results, [](const auto& t_result) {
+        return !t_result.second.state->totals[t_result.second.total].finished;
+    });
+}
+
+void ic::data::DirectorySizer::Clear()
+{
+    Cancel();
+    m_results.clear();
+}
+
+void ic::data::DirectorySizer::Update()
+{
+    // a cancelled job is joined as soon as its threads have noticed the stop
+    std::erase_if(m_jobs, [](const Job& t_job) {
+        return t_job.state->finished.load();
+    });
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::DirectorySizer::Run(const std::stop_token& t_stopToken, State& t_state)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+
+    const auto count{ std::clamp(std::thread::hardware_concurrency(), 1u, 8u) };
+    std::vector<Queue> queues(count);
+
+    t_state.pending = t_state.directories.size();
+    for (std::size_t i{ 0 }; i < t_state.directories.size(); ++i)
+    {
+        t_state.totals[i].pending = 1;
+        queues[i % count].tasks.push_back({ t_state.directories[i], i, true });
+    }
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(count);
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            workers.emplace_back([&, i] {
+                Work(t_stopToken, t_state, queues, i);
+            });
+        }
+    }
+
+    IC_LOG_DEBUG("[DirectorySizer::Run()] {} after {} ms.",
+        t_stopToken.stop_requested() ? "Cancelled" : "Finished",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+    t_state.finished = true;
+}
+
+void ic::data::DirectorySizer::Work(const std::stop_token& t_stopToken, State& t_state, std::vector<Queue>& t_queues, const std::size_t t_self)
+{
+    application::Util::LowerThreadPriority();
+
+    std::vector<Task> children;
+    while (!t_stopToken.stop_requested())
+    {
+        const auto task{ Pop(t_queues, t_self) };
+        if (!task)
+        {
+            // the other threads may still find subdirectories
+            if (t_state.pending == 0)
+            {
+                return;
+            }
+
+            std::this_thread::sleep_for(IDLE_WAIT);
+            continue;
+        }
+
+        children.clear();
+        Read(t_state, *task, children);
+
+        // the counters are raised before the task is done, so they never drop to zero too early
+        auto& total{ t_state.totals[task->total] };
+        if (!children.empty())
+        {
+            total.pending += children.size();
+            t_state.pending += children.size();
+
+            std::scoped_lock lock{ t_queues[t_self].mutex };
+            std::ranges::move(children, std::back_inserter(t_queues[t_self].tasks));
+        }
+
+        if (total.pending.fetch_sub(1) == 1)
+        {
+            total.finished = true;
+        }
+
+        --t_state.pending;
+    }
+}
+
+std::optional<ic::data::DirectorySizer::Task> ic::data::DirectorySizer::Pop(std::vector<Queue>& t_queues, const std::size_t t_self)
+{
+    // the own directories depth first ...
+    {
+        auto& queue{ t_queues[t_self] };
+        std::scoped_lock lock{ queue.mutex };
+        if (!queue.tasks.empty())
+        {
+            auto task{ std::move(queue.tasks.back()) };
+            queue.tasks.pop_back();
+
+            return task;
+        }
+    }
+
+    // ... otherwise the oldest directory of another thread, which probably has the most below it
+    for (std::size_t i{ 1 }; i < t_queues.size(); ++i)
+    {
+        auto& queue{ t_queues[(t_self + i) % t_queues.size()] };
+        std::scoped_lock lock{ queue.mutex };
+        if (!queue.tasks.empty())
+        {
+            auto task{ std::move(queue.tasks.front()) };
+            queue.tasks.pop_front();
+
+            return task;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void ic::data::DirectorySizer::Read(State& t_state, const Task& t_task, std::vector<Task>& t_children)
+{
+    auto& total{ t_state.totals[t_task.total] };
+
+    std::uint64_t apparent{ 0 };
+    std::uint64_t allocated{ 0 };
+    std::uint64_t files{ 0 };
+    std::uint64_t directories{ 0 };
+
+    const auto publish{ [&] {
+        total.apparent += std::exchange(apparent, 0);
+        total.allocated += std::exchange(allocated, 0);
+        total.files += std::exchange(files, 0);
+        total.directories += std::exchange(directories, 0);
+    } };
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    GetdentsReader reader{ t_task.path, READ_BUFFER_SIZE };
+    if (!reader.IsOpen())
+    {
+        return;
+    }
+
+    struct stat st{};
+
+    // the requested directory counts itself, all others are counted by their parent
+    if (t_task.top && fstat(reader.GetFd(), &st) == 0)
+    {
+        apparent += static_cast<std::uint64_t>(st.st_size);
+        allocated += static_cast<std::uint64_t>(st.st_blocks) * 512;
+    }
+
+    // the totals are published after each buffer, so that large directories grow visibly
+    while (reader.Read([&](const std::string_view t_name, [[maybe_unused]] const unsigned char t_type) {
+        if (IC_PROFILE_FS(FSTATAT, "DirectorySizer::Read", fstatat(reader.GetFd(), t_name.data(), &st, AT_SYMLINK_NOFOLLOW)) != 0)
+        {
+            return;
+        }
+
+        if (S_ISDIR(st.st_mode))
+        {
+            ++directories;
+            if (auto child{ t_task.path / t_name }; !application::Util::IsPseudoFileSystem(child))
+            {
+                t_children.push_back({ std::move(child), t_task.total, false });
+            }
+        }
+        else
+        {
+            // hard links are counted once
+            if (st.st_nlink > 1 && !IsFirstLink(t_state, st.st_dev, st.st_ino))
+            {
+                return;
+            }
+
+            ++files;
+        }
+
+        apparent += static_cast<std::uint64_t>(st.st_size);
+        allocated += static_cast<std::uint64_t>(st.st_blocks) * 512;
+    }))
+    {
+        publish();
+    }
+#else
+    std::error_code ec;
+    std::filesystem::directory_iterator it{ t_task.path, std::filesystem::directory_options::skip_permission_denied, ec };
+    if (ec)
+    {
+        return;
+    }
+
+    // symbolic links and junctions are not followed
+    for (const std::filesystem::directory_iterator end; !ec && it != end; it.increment(ec))
+    {
+        std::error_code entryEc;
+        const auto status{ it->symlink_status(entryEc) };
+        if (entryEc)
+        {
+            continue;
+        }
+
+        if (std::filesystem::is_directory(status))
+        {
+            ++directories;
+            t_children.push_back({ it->path(), t_task.total, false });
+        }
+        else if (std::filesystem::is_regular_file(status))
+        {
+            ++files;
+            if (const auto size{ it->file_size(entryEc) }; !entryEc)
+            {
+                // the allocated size is not available
+                apparent += size;
+                allocated += size;
+            }
+        }
+    }
+#endif
+
+    publish();
+}
+
+bool ic::data::DirectorySizer::IsFirstLink(State& t_state, const std::uint64_t t_device, const std::uint64_t t_inode)
+{
+    auto& shard{ t_state.inodes[t_inode % t_state.inodes.size()] };
+    std::scoped_lock lock{ shard.mutex };
+
+    return shard.inodes.insert({ t_device, t_inode }).second;
+}
@@ -0,0 +1,246 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <deque>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <cstdint>
+
+namespace ic::data
+{
+    /**
+     * Computes the total size of directories in the background, like ncdu or du.
+     * The subdirectories are read by a pool of threads; idle threads steal directories
+     * from the others. The totals grow while the directories are read.
+     */
+    class DirectorySizer
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Totals
+        {
+            /**
+             * The sum of the file sizes.
+             */
+            std::uint64_t apparent{ 0 };
+
+            /**
+             * The disk space used; the apparent size where it is not known.
+             */
+            std::uint64_t allocated{ 0 };
+
+            std::uint64_t files{ 0 };
+            std::uint64_t directories{ 0 };
+
+            /**
+             * Is set when all subdirectories have been read.
+             */
+            bool finished{ false };
+        };
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * How long a thread without work waits before it tries to steal again.
+         */
+        static constexpr std::chrono::microseconds IDLE_WAIT{ 100 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        DirectorySizer();
+
+        DirectorySizer(const DirectorySizer& t_other) = delete;
+        DirectorySizer(DirectorySizer&& t_other) noexcept = delete;
+        DirectorySizer& operator=(const DirectorySizer& t_other) = delete;
+        DirectorySizer& operator=(DirectorySizer&& t_other) noexcept = delete;
+
+        ~DirectorySizer() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsRunning() const;
+
+        /**
+         * @param t_path A directory.
+         *
+         * @return The current totals or nothing if the directory has not been requested.
+         */
+        [[nodiscard]] std::optional<Totals> Get(const std::filesystem::path& t_path) const;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Starts computing the sizes of directories. A running computation is cancelled,
+         * the totals of finished directories are kept.
+         *
+         * @param t_directories The directories.
+         */
+        void Start(std::vector<std::filesystem::path> t_directories);
+
+        /**
+         * Stops a running computation and discards the unfinished totals.
+         */
+        void Cancel();
+
+        /**
+         * Stops a running computation and discards all totals.
+         */
+        void Clear();
+
+        /**
+         * Joins finished computations. Must be called from the UI thread.
+         */
+        void Update();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Total
+        {
+            std::atomic<std::uint64_t> apparent{ 0 };
+            std::atomic<std::uint64_t> allocated{ 0 };
+            std::atomic<std::uint64_t> files{ 0 };
+            std::atomic<std::uint64_t> directories{ 0 };
+
+            /**
+             * The number of directories that are not read yet.
+             */
+            std::atomic<std::size_t> pending{ 0 };
+            std::atomic_bool finished{ false };
+        };
+
+        struct Task
+        {
+            std::filesystem::path path;
+            std::size_t total{ 0 };
+
+            // the requested directory itself
+            bool top{ false };
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        struct Inode
+        {
+            std::uint64_t device;
+            std::uint64_t inode;
+
+            bool operator==(const Inode& t_other) const = default;
+        };
+
+        struct InodeHash
+        {
+            std::size_t operator()(const Inode& t_inode) const
+            {
+                return std::hash<std::uint64_t>{}(t_inode.inode ^ (t_inode.device << 32));
+            }
+        };
+
+        struct InodeShard
+        {
+            std::mutex mutex;
+            std::unordered_set<Inode, InodeHash> inodes;
+        };
+
+        /**
+         * Shared by the threads of one computation.
+         */
+        struct State
+        {
+            std::vector<std::filesystem::path> directories;
+            std::unique_ptr<Total[]> totals;
+
+            /**
+             * The number of directories that are not read yet.
+             */
+            std::atomic<std::size_t> pending{ 0 };
+
+            /**
+             * Files with more than one hard link; the shards reduce the lock contention.
+             */
+            std::array<InodeShard, 16> inodes;
+
+            std::atomic_bool finished{ false };
+        };
+
+        struct Job
+        {
+            std::shared_ptr<State> state;
+            std::jthread thread;
+        };
+
+        struct Result
+        {
+            std::shared_ptr<State> state;
+            std::size_t total;
+        };
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::size_t READ_BUFFER_SIZE{ 64 * 1024 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        std::vector<Job> m_jobs;
+        std::unordered_map<std::filesystem::path::string_type, Result> m_results;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        static void Run(const std::stop_token& t_stopToken, State& t_state);
+        static void Work(const std::stop_token& t_stopToken, State& t_state, std::vector<Queue>& t_queues, std::size_t t_self);
+        [[nodiscard]] static std::optional<Task> Pop(std::vector<Queue>& t_queues, std::size_t t_self);
+        static void Read(State& t_state, const Task& t_task, std::vector<Task>& t_children);
+        [[nodiscard]] static bool IsFirstLink(State& t_state, std::uint64_t t_device, std::uint64_t t_inode);
+    };
+}
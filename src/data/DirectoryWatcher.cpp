@@ -0,0 +1,181 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "DirectoryWatcher.h"
+#include "Log.h"
+#include "IcProfile.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::DirectoryWatcher::DirectoryWatcher()
+{
+    IC_LOG_DEBUG("[DirectoryWatcher::DirectoryWatcher()] Create DirectoryWatcher.");
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0)
+    {
+        IC_LOG_WARN("[DirectoryWatcher::DirectoryWatcher()] Unable to initialize inotify: {}", std::strerror(errno));
+    }
+#endif
+}
+
+ic::data::DirectoryWatcher::~DirectoryWatcher() noexcept
+{
+    IC_LOG_DEBUG("[DirectoryWatcher::~DirectoryWatcher()] Destruct DirectoryWatcher.");
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+#endif
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::DirectoryWatcher::Watch([[maybe_unused]] const std::filesystem::path& t_path)
+{
+    Stop();
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    if (m_fd < 0)
+    {
+        return;
+    }
+
+    constexpr uint32_t mask{
+        IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+        IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK
+    };
+
+    m_wd = IC_PROFILE_FS(INOTIFY, "DirectoryWatcher::Watch", inotify_add_watch(m_fd, t_path.c_str(), mask));
+    if (m_wd < 0)
+    {
+        IC_LOG_WARN("[DirectoryWatcher::Watch()] Unable to watch {}: {}", t_path.string(), std::strerror(errno));
+    }
+#endif
+}
+
+void ic::data::DirectoryWatcher::Stop()
+{
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    if (m_wd >= 0)
+    {
+        inotify_rm_watch(m_fd, m_wd);
+        m_wd = -1;
+    }
+
+    // drop the events of the old watch
+    ReadEvents();
+#endif
+
+    m_pending.clear();
+    m_overflow = false;
+}
+
+bool ic::data::DirectoryWatcher::Poll(Changes& t_changes)
+{
+    if (!IsWatching())
+    {
+        return false;
+    }
+
+    ReadEvents();
+
+    if (m_pending.empty() && !m_overflow)
+    {
+        return false;
+    }
+
+    const auto now{ std::chrono::steady_clock::now() };
+    if (now - m_lastEvent < QUIET_PERIOD && now - m_firstEvent < MAX_DELAY)
+    {
+        return false;
+    }
+
+    t_changes.rescan = m_overflow || m_pending.size() > MAX_CHANGES;
+    t_changes.names.clear();
+    if (!t_changes.rescan)
+    {
+        t_changes.names.assign(m_pending.begin(), m_pending.end());
+    }
+
+    m_pending.clear();
+    m_overflow = false;
+
+    return true;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::DirectoryWatcher::ReadEvents()
+{
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    if (m_fd < 0)
+    {
+        return;
+    }
+
+    alignas(inotify_event) char buffer[64 * 1024];
+
+    ssize_t bytes;
+    while ((bytes = IC_PROFILE_FS(INOTIFY, "DirectoryWatcher::ReadEvents", read(m_fd, buffer, sizeof(buffer)))) > 0)
+    {
+        for (ssize_t offset{ 0 }; offset < bytes;)
+        {
+            const auto* event{ reinterpret_cast<const inotify_event*>(buffer + offset) };
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            // events of a removed watch
+            if (event->wd != m_wd && !(event->mask & IN_Q_OVERFLOW))
+            {
+                continue;
+            }
+
+            if (m_pending.empty() && !m_overflow)
+            {
+                m_firstEvent = std::chrono::steady_clock::now();
+            }
+            m_lastEvent = std::chrono::steady_clock::now();
+
+            if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF))
+            {
+                m_overflow = true;
+            }
+            else if (event->len > 0 && m_pending.size() <= MAX_CHANGES)
+            {
+                m_pending.emplace(event->name);
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,138 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <chrono>
+
+namespace ic::data
+{
+    /**
+     * Watches a directory with inotify (Linux only) and coalesces the events.
+     * On other platforms nothing is watched.
+     */
+    class DirectoryWatcher
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Changes
+        {
+            /**
+             * The names of the entries that were created, deleted, renamed or modified.
+             */
+            std::vector<std::string> names;
+
+            /**
+             * Is set if the changes are unknown and the directory has to be read again.
+             */
+            bool rescan{ false };
+        };
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The changes are reported when no event arrived for this time ...
+         */
+        static constexpr std::chrono::milliseconds QUIET_PERIOD{ 100 };
+
+        /**
+         * ... or at the latest after this time during a burst of events.
+         */
+        static constexpr std::chrono::milliseconds MAX_DELAY{ 500 };
+
+        /**
+         * With more changed entries a rescan is cheaper.
+         */
+        static constexpr std::size_t MAX_CHANGES{ 4096 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        DirectoryWatcher();
+
+        DirectoryWatcher(const DirectoryWatcher& t_other) = delete;
+        DirectoryWatcher(DirectoryWatcher&& t_other) noexcept = delete;
+        DirectoryWatcher& operator=(const DirectoryWatcher& t_other) = delete;
+        DirectoryWatcher& operator=(DirectoryWatcher&& t_other) noexcept = delete;
+
+        ~DirectoryWatcher() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsWatching() const { return m_wd >= 0; }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Watches the given directory instead of the previous one.
+         *
+         * @param t_path The directory to watch.
+         */
+        void Watch(const std::filesystem::path& t_path);
+
+        /**
+         * Stops watching.
+         */
+        void Stop();
+
+        /**
+         * Reads the pending events without blocking.
+         *
+         * @param t_changes Receives the coalesced changes, if they are ready.
+         *
+         * @return True if changes were received.
+         */
+        bool Poll(Changes& t_changes);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        int m_fd{ -1 };
+        int m_wd{ -1 };
+
+        std::unordered_set<std::string> m_pending;
+        bool m_overflow{ false };
+
+        std::chrono::steady_clock::time_point m_firstEvent;
+        std::chrono::steady_clock::time_point m_lastEvent;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void ReadEvents();
+    };
+}
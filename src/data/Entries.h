@@ -18,14 +18,382 @@
 
 #pragma once
 
-#include <set>
-#include <filesystem>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <unordered_set>
+#include <thread>
+#include <optional>
+#include <stop_token>
+#include "Entry.h"
+#include "Comparator.h"
+#include "Collation.h"
 
 namespace ic::data
 {
-    template <typename Compare>
+    /**
+     * A row refers to an entry and holds the sort prefix of that entry.
+     */
+    struct Row
+    {
+        std::uint64_t prefix{ 0 };
+        std::uint32_t index{ 0 };
+    };
+
+    /**
+     * The entries of a directory and their order.
+     * The sort algorithms are instantiated for each comparator (see WithComparator()),
+     * so the comparisons are resolved at compile time.
+     */
     struct Entries
     {
-        std::set<std::filesystem::path, Compare> filesAndDirs;
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Fewer rows per thread are sorted by one thread.
+         */
+        static constexpr std::ptrdiff_t PARALLEL_MIN_ROWS{ 32'768 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The files and directories in the order in which they were read.
+         */
+        std::vector<Entry> filesAndDirs;
+
+        /**
+         * The rows sorted by the sortSpec.
+         */
+        std::vector<Row> rows;
+
+        /**
+         * The order of the rows.
+         */
+        SortSpec sortSpec;
+
+        /**
+         * Incremented whenever indices into filesAndDirs become invalid.
+         * Insert() only appends, so the indices stay valid.
+         */
+        std::size_t generation{ 0 };
+
+        /**
+         * Incremented whenever the rows change.
+         */
+        std::size_t revision{ 0 };
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] const Entry& At(const std::size_t t_row) const
+        {
+            return filesAndDirs[rows[t_row].index];
+        }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Adds entries. The new rows are sorted and merged into the existing rows.
+         *
+         * @param t_batches The entries to add.
+         */
+        void Insert(std::vector<std::vector<Entry>>&& t_batches)
+        {
+            if (sortSpec.natural)
+            {
+                for (auto& batch : t_batches)
+                {
+                    CreateNaturalKeys(batch);
+                }
+            }
+
+            WithComparator(sortSpec, [&]<typename Compare>(Compare) {
+                InsertRows<Compare>(std::move(t_batches));
+            });
+
+            ++revision;
+        }
+
+        /**
+         * Sorts a copy of the rows in another order. The entries are not read again.
+         * Only their natural keys are written, so other threads may read the entries
+         * meanwhile, but must not change them.
+         *
+         * @param t_stopToken Stops sorting.
+         * @param t_sortSpec The new order.
+         *
+         * @return The sorted rows or nothing if stopped.
+         */
+        [[nodiscard]] std::optional<std::vector<Row>> SortedRows(const std::stop_token& t_stopToken, const SortSpec& t_sortSpec)
+        {
+            if (t_sortSpec.natural)
+            {
+                CreateNaturalKeys(filesAndDirs);
+            }
+
+            auto sorted{ rows };
+            WithComparator(t_sortSpec, [&]<typename Compare>(Compare) {
+                for (auto& row : sorted)
+                {
+                    row.prefix = Compare::Prefix(filesAndDirs[row.index], 0);
+                }
+
+                SortParallel<Compare>(t_stopToken, sorted.begin(), sorted.end());
+            });
+
+            if (t_stopToken.stop_requested())
+            {
+                return std::nullopt;
+            }
+
+            return sorted;
+        }
+
+        /**
+         * Replaces the rows by the rows of SortedRows().
+         *
+         * @param t_rows The sorted rows.
+         * @param t_sortSpec The order of the rows.
+         */
+        void SetRows(std::vector<Row>&& t_rows, const SortSpec& t_sortSpec)
+        {
+            rows = std::move(t_rows);
+            sortSpec = t_sortSpec;
+            ++revision;
+        }
+
+        /**
+         * Removes the entries with the given names.
+         *
+         * @param t_names The names of the entries to remove.
+         */
+        void Remove(const std::vector<std::string>& t_names)
+        {
+            const std::unordered_set<std::string_view> names(t_names.begin(), t_names.end());
+
+            // the new index of each entry; removed entries get REMOVED
+            static constexpr auto REMOVED{ std::numeric_limits<std::uint32_t>::max() };
+            std::vector<std::uint32_t> newIndices(filesAndDirs.size(), REMOVED);
+
+            std::uint32_t newIndex{ 0 };
+            for (std::size_t i{ 0 }; i < filesAndDirs.size(); ++i)
+            {
+                if (!names.contains(filesAndDirs[i].name))
+                {
+                    if (newIndex != i)
+                    {
+                        filesAndDirs[newIndex] = std::move(filesAndDirs[i]);
+                    }
+                    newIndices[i] = newIndex++;
+                }
+            }
+
+            if (newIndex == filesAndDirs.size())
+            {
+                return;
+            }
+
+            filesAndDirs.resize(newIndex);
+            ++generation;
+            ++revision;
+
+            std::erase_if(rows, [&](Row& t_row) {
+                t_row.index = newIndices[t_row.index];
+                return t_row.index == REMOVED;
+            });
+        }
+
+        void Clear()
+        {
+            filesAndDirs.clear();
+            rows.clear();
+            ++generation;
+            ++revision;
+        }
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        using RowIterator = std::vector<Row>::iterator;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * The natural keys are created once, when they are needed for the first time.
+         *
+         * @param t_entries The entries.
+         */
+        static void CreateNaturalKeys(std::vector<Entry>& t_entries)
+        {
+            for (auto& entry : t_entries)
+            {
+                if (entry.naturalKey.empty())
+                {
+                    entry.naturalKey = Collation::NaturalKey(entry.sortKey);
+                }
+            }
+        }
+
+        template <typename Compare>
+        void InsertRows(std::vector<std::vector<Entry>>&& t_batches)
+        {
+            const auto oldSize{ rows.size() };
+
+            auto newSize{ oldSize };
+            for (const auto& batch : t_batches)
+            {
+                newSize += batch.size();
+            }
+            filesAndDirs.reserve(newSize);
+            rows.reserve(newSize);
+
+            for (auto& batch : t_batches)
+            {
+                for (auto& entry : batch)
+                {
+                    rows.push_back({ Compare::Prefix(entry, 0), static_cast<std::uint32_t>(filesAndDirs.size()) });
+                    filesAndDirs.push_back(std::move(entry));
+                }
+            }
+
+            const auto middle{ rows.begin() + static_cast<std::ptrdiff_t>(oldSize) };
+            SortParallel<Compare>({}, middle, rows.end());
+            std::inplace_merge(rows.begin(), middle, rows.end(), [this](const Row& t_a, const Row& t_b) { return Less<Compare>(t_a, t_b); });
+        }
+
+        /**
+         * Splits the rows into one part per thread, sorts the parts
+         * at the same time and merges them pairwise.
+         *
+         * @param t_stopToken Stops sorting; the rows are left unordered.
+         * @param t_first The first row.
+         * @param t_last The end of the rows.
+         */
+        template <typename Compare>
+        void SortParallel(const std::stop_token& t_stopToken, const RowIterator t_first, const RowIterator t_last)
+        {
+            const auto count{ t_last - t_first };
+            const auto parts{ std::min<std::ptrdiff_t>(std::max(1u, std::thread::hardware_concurrency()), count / PARALLEL_MIN_ROWS) };
+            if (parts < 2)
+            {
+                SortRows<Compare>(t_stopToken, t_first, t_last, 0);
+                return;
+            }
+
+            std::vector<RowIterator> bounds;
+            for (std::ptrdiff_t i{ 0 }; i <= parts; ++i)
+            {
+                bounds.push_back(t_first + count * i / parts);
+            }
+
+            {
+                std::vector<std::jthread> workers;
+                for (std::ptrdiff_t i{ 0 }; i < parts; ++i)
+                {
+                    workers.emplace_back([this, &t_stopToken, &bounds, i] {
+                        SortRows<Compare>(t_stopToken, bounds[i], bounds[i + 1], 0);
+                    });
+                }
+            }
+
+            for (std::ptrdiff_t width{ 1 }; width < parts && !t_stopToken.stop_requested(); width *= 2)
+            {
+                std::vector<std::jthread> workers;
+                for (std::ptrdiff_t i{ 0 }; i + width < parts; i += 2 * width)
+                {
+                    workers.emplace_back([this, first = bounds[i], middle = bounds[i + width], last = bounds[std::min(i + 2 * width, parts)]] {
+                        std::inplace_merge(first, middle, last, [this](const Row& t_a, const Row& t_b) { return Less<Compare>(t_a, t_b); });
+                    });
+                }
+            }
+        }
+
+        /**
+         * Sorts rows level by level: the rows are sorted by their prefix,
+         * then each run of equal prefixes is sorted by the prefix of the next level.
+         * Apart from the ties, no entry has to be read during a comparison.
+         *
+         * @param t_stopToken Stops sorting; the rows are left unordered.
+         * @param t_first The first row.
+         * @param t_last The end of the rows.
+         * @param t_level The level of the prefixes to sort by.
+         */
+        template <typename Compare>
+        void SortRows(const std::stop_token& t_stopToken, const RowIterator t_first, const RowIterator t_last, const std::size_t t_level)
+        {
+            if (t_last - t_first < 2 || t_stopToken.stop_requested())
+            {
+                return;
+            }
+
+            // the prefixes of the previous level are equal within the range and restored at the end
+            const auto previousPrefix{ t_first->prefix };
+            auto moreLevels{ t_level == 0 };
+            if (t_level > 0)
+            {
+                for (auto it{ t_first }; it != t_last; ++it)
+                {
+                    const auto& entry{ filesAndDirs[it->index] };
+                    it->prefix = Compare::Prefix(entry, t_level);
+                    moreLevels = moreLevels || Compare::Levels(entry) > t_level;
+                }
+            }
+
+            if (moreLevels)
+            {
+                std::sort(t_first, t_last, [](const Row& t_a, const Row& t_b) { return t_a.prefix < t_b.prefix; });
+
+                for (auto runFirst{ t_first }; runFirst != t_last;)
+                {
+                    auto runLast{ runFirst + 1 };
+                    while (runLast != t_last && runLast->prefix == runFirst->prefix)
+                    {
+                        ++runLast;
+                    }
+
+                    SortRows<Compare>(t_stopToken, runFirst, runLast, t_level + 1);
+                    runFirst = runLast;
+                }
+            }
+            else
+            {
+                // the prefixes are exhausted
+                std::sort(t_first, t_last, [this](const Row& t_a, const Row& t_b) {
+                    return Compare()(filesAndDirs[t_a.index], filesAndDirs[t_b.index]);
+                });
+            }
+
+            if (t_level > 0)
+            {
+                for (auto it{ t_first }; it != t_last; ++it)
+                {
+                    it->prefix = previousPrefix;
+                }
+            }
+        }
+
+        template <typename Compare>
+        [[nodiscard]] bool Less(const Row& t_a, const Row& t_b) const
+        {
+            if (t_a.prefix != t_b.prefix)
+            {
+                return t_a.prefix < t_b.prefix;
+            }
+
+            return Compare()(filesAndDirs[t_a.index], filesAndDirs[t_b.index]);
+        }
     };
 }
@@ -0,0 +1,203 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "Entry.h"
+#include "Collation.h"
+#include "application/Util.h"
+#include "IcProfile.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <dirent.h>
+    #include <cerrno>
+#endif
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::Entry::Entry(const std::filesystem::directory_entry& t_dirEntry)
+    : path{ t_dirEntry.path() }
+{
+    // the error_code overloads are used: an entry can disappear while reading
+    std::error_code ec;
+
+    symlink = t_dirEntry.is_symlink(ec);
+
+    if (const auto status{ t_dirEntry.status(ec) }; !ec)
+    {
+        permissions = status.permissions();
+
+        if (std::filesystem::is_regular_file(status))
+        {
+            type = EntryType::FILE;
+            size = t_dirEntry.file_size(ec);
+        }
+        else if (std::filesystem::is_directory(status))
+        {
+            type = EntryType::DIRECTORY;
+        }
+    }
+
+    if (const auto lastWrite{ t_dirEntry.last_write_time(ec) }; !ec)
+    {
+        lastWriteTime = lastWrite;
+    }
+
+#if defined(_WIN64) && defined(_MSC_VER)
+    name = application::Util::WstringConv(path);
+
+    if (IsDirectory())
+    {
+        accessible = !application::Util::IsAccessDenied(path.wstring());
+        junction = application::Util::IsJunctionDirectory(path.wstring());
+        hidden = application::Util::IsHiddenDirectory(path.wstring());
+    }
+#elif defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    name = path.filename().string();
+    accessible = IC_PROFILE_FS(ACCESS, "Entry::Entry", access(path.c_str(), R_OK)) == 0;
+    hidden = application::Util::IsHidden(path);
+#endif
+
+    sortKey = Collation::FoldCase(name);
+}
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+ic::data::Entry::Entry(const std::filesystem::path& t_dir, const std::string_view t_name, const unsigned char t_dType)
+    : path{ t_dir / t_name }
+    , name{ t_name }
+    , sortKey{ Collation::FoldCase(t_name) }
+    , hidden{ !t_name.empty() && t_name.front() == '.' }
+{
+    switch (t_dType)
+    {
+    case DT_REG:
+        type = EntryType::FILE;
+        break;
+    case DT_DIR:
+        type = EntryType::DIRECTORY;
+        break;
+    case DT_LNK:
+        // the type of the target is read with the metadata
+        symlink = true;
+        typeUnknown = true;
+        break;
+    case DT_UNKNOWN:
+        // not every filesystem fills d_type
+        typeUnknown = true;
+        break;
+    default:
+        type = EntryType::OTHER;
+        break;
+    }
+}
+
+//-------------------------------------------------
+// Metadata
+//-------------------------------------------------
+
+void ic::data::Entry::ReadMetadata(const int t_dirFd)
+{
+    struct stat st{};
+
+    if (!symlink)
+    {
+        if (IC_PROFILE_FS(FSTATAT, "Entry::ReadMetadata", fstatat(t_dirFd, name.c_str(), &st, AT_SYMLINK_NOFOLLOW)) != 0)
+        {
+            missing = errno == ENOENT;
+            type = EntryType::OTHER;
+            typeUnknown = false;
+            accessible = false;
+
+            return;
+        }
+
+        if (S_ISLNK(st.st_mode))
+        {
+            symlink = true;
+        }
+        else
+        {
+            SetMetadata(st);
+        }
+    }
+
+    if (symlink)
+    {
+        if (IC_PROFILE_FS(FSTATAT, "Entry::ReadMetadata", fstatat(t_dirFd, name.c_str(), &st, 0)) == 0)
+        {
+            SetMetadata(st);
+        }
+        else
+        {
+            // dangling
+            type = EntryType::OTHER;
+            typeUnknown = false;
+        }
+    }
+
+    accessible = IC_PROFILE_FS(ACCESS, "Entry::ReadMetadata", faccessat(t_dirFd, name.c_str(), R_OK, 0)) == 0;
+}
+
+void ic::data::Entry::SetMetadata(const struct stat& t_stat)
+{
+    if (S_ISREG(t_stat.st_mode))
+    {
+        type = EntryType::FILE;
+        size = static_cast<std::uintmax_t>(t_stat.st_size);
+    }
+    else if (S_ISDIR(t_stat.st_mode))
+    {
+        type = EntryType::DIRECTORY;
+    }
+    else
+    {
+        type = EntryType::OTHER;
+    }
+    typeUnknown = false;
+
+    const auto sinceEpoch{ std::chrono::seconds(t_stat.st_mtim.tv_sec) + std::chrono::nanoseconds(t_stat.st_mtim.tv_nsec) };
+    lastWriteTime = std::chrono::file_clock::from_sys(std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(sinceEpoch)));
+
+    permissions = static_cast<std::filesystem::perms>(t_stat.st_mode & 07777);
+}
+
+void ic::data::Entry::SetMetadata(const struct statx& t_statx)
+{
+    if (S_ISREG(t_statx.stx_mode))
+    {
+        type = EntryType::FILE;
+        size = t_statx.stx_size;
+    }
+    else if (S_ISDIR(t_statx.stx_mode))
+    {
+        type = EntryType::DIRECTORY;
+    }
+    else
+    {
+        type = EntryType::OTHER;
+    }
+    typeUnknown = false;
+
+    const auto sinceEpoch{ std::chrono::seconds(t_statx.stx_mtime.tv_sec) + std::chrono::nanoseconds(t_statx.stx_mtime.tv_nsec) };
+    lastWriteTime = std::chrono::file_clock::from_sys(std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(sinceEpoch)));
+
+    permissions = static_cast<std::filesystem::perms>(t_statx.stx_mode & 07777);
+}
+#endif
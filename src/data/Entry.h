@@ -0,0 +1,187 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <sys/stat.h>
+#endif
+
+namespace ic::data
+{
+    enum class EntryType
+    {
+        FILE, DIRECTORY, OTHER
+    };
+
+    /**
+     * A file or directory with all the information needed to render it.
+     * The data is captured once when the directory is read, so that
+     * rendering never has to touch the filesystem.
+     */
+    struct Entry
+    {
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The full path.
+         */
+        std::filesystem::path path;
+
+        /**
+         * The filename to display.
+         */
+        std::string name;
+
+        /**
+         * The case-folded name to sort by.
+         */
+        std::string sortKey;
+
+        /**
+         * The sortKey with numbers in natural order; only created for the natural sort order.
+         */
+        std::string naturalKey;
+
+        /**
+         * The type of the entry; symlinks are followed.
+         */
+        EntryType type{ EntryType::OTHER };
+
+        /**
+         * The size in bytes of a regular file.
+         */
+        std::uintmax_t size{ 0 };
+
+        /**
+         * The time of the last modification.
+         */
+        std::filesystem::file_time_type lastWriteTime;
+
+        /**
+         * The permissions; symlinks are followed.
+         */
+        std::filesystem::perms permissions{ std::filesystem::perms::unknown };
+
+        /**
+         * Is set if the entry itself is a symlink.
+         */
+        bool symlink{ false };
+
+        /**
+         * Is set if the entry is a hidden file or directory.
+         */
+        bool hidden{ false };
+
+        /**
+         * Is set if the entry is readable.
+         */
+        bool accessible{ true };
+
+        /**
+         * Is set if the entry is a junction (Win64 only).
+         */
+        bool junction{ false };
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+        /**
+         * Is set as long as the type could not be taken from the d_type.
+         */
+        bool typeUnknown{ false };
+
+        /**
+         * Is set if the entry no longer exists when the metadata are read.
+         */
+        bool missing{ false };
+#endif
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Entry() = default;
+
+        explicit Entry(const std::filesystem::directory_entry& t_dirEntry);
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+        /**
+         * Creates an entry from a getdents64 record. The type is taken from t_dType.
+         * The metadata are not read yet, see ReadMetadata().
+         *
+         * @param t_dir The directory that contains the entry.
+         * @param t_name The filename.
+         * @param t_dType The d_type of the record.
+         */
+        Entry(const std::filesystem::path& t_dir, std::string_view t_name, unsigned char t_dType);
+#endif
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsFile() const { return type == EntryType::FILE; }
+        [[nodiscard]] bool IsDirectory() const { return type == EntryType::DIRECTORY; }
+
+        /**
+         * @param t_name A filename.
+         *
+         * @return The part after the last dot; empty for names like ".bashrc".
+         */
+        [[nodiscard]] static std::string_view GetExtension(const std::string_view t_name)
+        {
+            const auto pos{ t_name.rfind('.') };
+
+            return pos == std::string_view::npos || pos == 0 ? std::string_view() : t_name.substr(pos + 1);
+        }
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+        //-------------------------------------------------
+        // Metadata
+        //-------------------------------------------------
+
+        /**
+         * Reads the metadata with fstatat relative to the directory.
+         * Symlinks are followed; an unknown type is resolved on the way.
+         *
+         * @param t_dirFd A file descriptor of the directory that contains the entry.
+         */
+        void ReadMetadata(int t_dirFd);
+
+        /**
+         * Sets type, size, last write time and permissions from a (followed) stat result.
+         *
+         * @param t_stat The stat result.
+         */
+        void SetMetadata(const struct stat& t_stat);
+
+        /**
+         * Sets type, size, last write time and permissions from a (followed) statx result.
+         *
+         * @param t_statx The statx result.
+         */
+        void SetMetadata(const struct statx& t_statx);
+#endif
+    };
+}
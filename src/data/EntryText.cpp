@@ -0,0 +1,252 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <charconv>
+#include <algorithm>
+#include <ctime>
+#include "EntryText.h"
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::EntryText::Sync(const std::size_t t_generation, const std::size_t t_count, const SizeFormat t_sizeFormat, const TimeFormat t_timeFormat)
+{
+    const auto now{ std::chrono::system_clock::now() };
+
+    if (t_generation != m_generation ||
+        t_sizeFormat != m_sizeFormat ||
+        t_timeFormat != m_timeFormat ||
+        (m_timeFormat == TimeFormat::RELATIVE && now - m_now >= RELATIVE_INTERVAL))
+    {
+        Clear();
+
+        m_generation = t_generation;
+        m_sizeFormat = t_sizeFormat;
+        m_timeFormat = t_timeFormat;
+        m_now = now;
+    }
+
+    // new entries are appended within a generation
+    m_slots.resize(t_count);
+}
+
+std::string_view ic::data::EntryText::GetSize(const std::size_t t_index, const Entry& t_entry)
+{
+    const auto& slot{ Format(t_index, t_entry) };
+
+    return { m_buffer.data() + slot.offset, slot.sizeLength };
+}
+
+std::string_view ic::data::EntryText::GetSize(const std::uint64_t t_bytes)
+{
+    const auto end{ FormatSize(m_scratch.data(), m_scratch.data() + m_scratch.size(), t_bytes) };
+
+    return { m_scratch.data(), static_cast<std::size_t>(end - m_scratch.data()) };
+}
+
+std::string_view ic::data::EntryText::GetTime(const std::size_t t_index, const Entry& t_entry)
+{
+    const auto& slot{ Format(t_index, t_entry) };
+
+    return { m_buffer.data() + slot.offset + slot.sizeLength, slot.timeLength };
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+ic::data::EntryText::Slot& ic::data::EntryText::Format(const std::size_t t_index, const Entry& t_entry)
+{
+    auto& slot{ m_slots[t_index] };
+    if (slot.offset != UNFORMATTED)
+    {
+        return slot;
+    }
+
+    char text[2 * MAX_LENGTH];
+    const auto sizeEnd{ FormatSize(text, text + MAX_LENGTH, t_entry.size) };
+    const auto timeEnd{ FormatTime(sizeEnd, sizeEnd + MAX_LENGTH, t_entry.lastWriteTime) };
+
+    slot.offset = static_cast<std::uint32_t>(m_buffer.size());
+    slot.sizeLength = static_cast<std::uint8_t>(sizeEnd - text);
+    slot.timeLength = static_cast<std::uint8_t>(timeEnd - sizeEnd);
+    m_buffer.insert(m_buffer.end(), text, timeEnd);
+
+    return slot;
+}
+
+char* ic::data::EntryText::FormatSize(char* t_first, char* t_last, const std::uint64_t t_bytes) const
+{
+    if (m_sizeFormat == SizeFormat::BYTES)
+    {
+        char digits[24];
+        const auto end{ std::to_chars(digits, digits + sizeof(digits), t_bytes).ptr };
+        const auto count{ end - digits };
+
+        for (std::ptrdiff_t i{ 0 }; i < count; ++i)
+        {
+            if (i > 0 && (count - i) % 3 == 0)
+            {
+                *t_first++ = ',';
+            }
+            *t_first++ = digits[i];
+        }
+
+        return std::ranges::copy(std::string_view(" B "), t_first).out;
+    }
+
+    static constexpr float gb{ 1024.0f * 1024.0f * 1024.0f };
+    static constexpr float mb{ 1024.0f * 1024.0f };
+    static constexpr float kb{ 1024.0f };
+
+    auto bytes{ static_cast<float>(t_bytes) };
+    std::string_view unit{ " B " };
+    if (bytes > gb)
+    {
+        bytes /= gb;
+        unit = " Gb ";
+    }
+    else if (bytes > mb)
+    {
+        bytes /= mb;
+        unit = " Mb ";
+    }
+    else if (bytes > kb)
+    {
+        bytes /= kb;
+        unit = " Kb ";
+    }
+
+    t_first = std::to_chars(t_first, t_last, bytes, std::chars_format::fixed, 2).ptr;
+
+    return std::ranges::copy(unit, t_first).out;
+}
+
+char* ic::data::EntryText::FormatTime(char* t_first, char* t_last, const std::filesystem::file_time_type t_fileTime)
+{
+    using namespace std::chrono;
+
+#if defined(_WIN64) && defined(_MSC_VER)
+    const auto time{ floor<seconds>(utc_clock::to_sys(file_clock::to_utc(t_fileTime))) };
+#else
+    const auto time{ floor<seconds>(file_clock::to_sys(t_fileTime)) };
+#endif
+
+    const auto twoDigits{ [&t_first](const unsigned t_value) {
+        *t_first++ = static_cast<char>('0' + t_value / 10 % 10);
+        *t_first++ = static_cast<char>('0' + t_value % 10);
+    } };
+
+    if (m_timeFormat == TimeFormat::RELATIVE)
+    {
+        // times in the future and older than 30 days are shown as ISO
+        if (const auto age{ floor<seconds>(m_now) - time }; age >= seconds::zero() && age < days{ 30 })
+        {
+            if (age < minutes{ 1 })
+            {
+                return std::ranges::copy(std::string_view("just now"), t_first).out;
+            }
+
+            std::string_view unit{ " d ago" };
+            auto count{ duration_cast<days>(age).count() };
+            if (age < hours{ 1 })
+            {
+                unit = " min ago";
+                count = duration_cast<minutes>(age).count();
+            }
+            else if (age < days{ 1 })
+            {
+                unit = " h ago";
+                count = duration_cast<hours>(age).count();
+            }
+
+            t_first = std::to_chars(t_first, t_last, count).ptr;
+
+            return std::ranges::copy(unit, t_first).out;
+        }
+    }
+
+    const auto local{ time + seconds{ GetUtcOffset(time) } };
+    const auto day{ floor<days>(local) };
+    const year_month_day date{ day };
+    const hh_mm_ss clock{ local - day };
+
+    if (m_timeFormat == TimeFormat::LOCAL)
+    {
+        twoDigits(static_cast<unsigned>(date.day()));
+        *t_first++ = '.';
+        twoDigits(static_cast<unsigned>(date.month()));
+        *t_first++ = '.';
+        t_first = std::to_chars(t_first, t_last, static_cast<int>(date.year())).ptr;
+    }
+    else
+    {
+        t_first = std::to_chars(t_first, t_last, static_cast<int>(date.year())).ptr;
+        *t_first++ = '-';
+        twoDigits(static_cast<unsigned>(date.month()));
+        *t_first++ = '-';
+        twoDigits(static_cast<unsigned>(date.day()));
+    }
+
+    *t_first++ = ' ';
+    twoDigits(static_cast<unsigned>(clock.hours().count()));
+    *t_first++ = ':';
+    twoDigits(static_cast<unsigned>(clock.minutes().count()));
+
+    return t_first;
+}
+
+std::int32_t ic::data::EntryText::GetUtcOffset(const std::chrono::sys_seconds t_time)
+{
+    using namespace std::chrono;
+
+    const auto hour{ floor<hours>(t_time).time_since_epoch().count() };
+    if (const auto it{ m_utcOffsets.find(hour) }; it != m_utcOffsets.end())
+    {
+        return it->second;
+    }
+
+    const auto tt{ system_clock::to_time_t(t_time) };
+    std::tm tm{};
+#if defined(_WIN64) && defined(_MSC_VER)
+    localtime_s(&tm, &tt);
+#else
+    localtime_r(&tt, &tm);
+#endif
+
+    const auto local{
+        sys_days{ year{ tm.tm_year + 1900 } / month{ static_cast<unsigned>(tm.tm_mon + 1) } / day{ static_cast<unsigned>(tm.tm_mday) } } +
+        hours{ tm.tm_hour } + minutes{ tm.tm_min } + seconds{ tm.tm_sec }
+    };
+    const auto offset{ static_cast<std::int32_t>((local - t_time).count()) };
+
+    if (m_utcOffsets.size() > 4096)
+    {
+        m_utcOffsets.clear();
+    }
+    m_utcOffsets.emplace(hour, offset);
+
+    return offset;
+}
+
+void ic::data::EntryText::Clear()
+{
+    m_buffer.clear();
+    m_slots.clear();
+}
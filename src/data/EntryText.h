@@ -0,0 +1,170 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <string_view>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+#include "Entry.h"
+
+namespace ic::data
+{
+    enum class SizeFormat
+    {
+        HUMAN, BYTES
+    };
+
+    enum class TimeFormat
+    {
+        LOCAL, ISO, RELATIVE
+    };
+
+    /**
+     * The formatted size and modification time of the entries.
+     * An entry is formatted when it is shown for the first time;
+     * all strings share one buffer.
+     */
+    class EntryText
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        EntryText() = default;
+
+        EntryText(const EntryText& t_other) = delete;
+        EntryText(EntryText&& t_other) noexcept = delete;
+        EntryText& operator=(const EntryText& t_other) = delete;
+        EntryText& operator=(EntryText&& t_other) noexcept = delete;
+
+        ~EntryText() noexcept = default;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Discards the strings if they are out of date. Must be called once per frame.
+         *
+         * @param t_generation The generation of the entries; a new generation invalidates all indices.
+         * @param t_count The number of entries.
+         * @param t_sizeFormat How sizes are shown.
+         * @param t_timeFormat How times are shown.
+         */
+        void Sync(std::size_t t_generation, std::size_t t_count, SizeFormat t_sizeFormat, TimeFormat t_timeFormat);
+
+        /**
+         * @param t_index The index of the entry.
+         * @param t_entry The entry.
+         *
+         * @return The formatted size. Valid until the next call to Sync().
+         */
+        [[nodiscard]] std::string_view GetSize(std::size_t t_index, const Entry& t_entry);
+
+        /**
+         * Formats a size that changes too often to be kept, e.g. a growing directory total.
+         *
+         * @param t_bytes The size in bytes.
+         *
+         * @return The formatted size. Valid until the next call of this function.
+         */
+        [[nodiscard]] std::string_view GetSize(std::uint64_t t_bytes);
+
+        /**
+         * @param t_index The index of the entry.
+         * @param t_entry The entry.
+         *
+         * @return The formatted modification time. Valid until the next call to Sync().
+         */
+        [[nodiscard]] std::string_view GetTime(std::size_t t_index, const Entry& t_entry);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * Locates the strings of an entry in the buffer.
+         */
+        struct Slot
+        {
+            std::uint32_t offset{ UNFORMATTED };
+            std::uint8_t sizeLength{ 0 };
+            std::uint8_t timeLength{ 0 };
+        };
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr auto UNFORMATTED{ UINT32_MAX };
+
+        /**
+         * Enough for the longest size and the longest time.
+         */
+        static constexpr std::size_t MAX_LENGTH{ 64 };
+
+        /**
+         * Relative times are formatted again after this time.
+         */
+        static constexpr std::chrono::seconds RELATIVE_INTERVAL{ 30 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        std::vector<char> m_buffer;
+        std::vector<Slot> m_slots;
+        std::array<char, MAX_LENGTH> m_scratch{};
+
+        std::size_t m_generation{ 0 };
+        SizeFormat m_sizeFormat{ SizeFormat::HUMAN };
+        TimeFormat m_timeFormat{ TimeFormat::LOCAL };
+
+        /**
+         * The time relative times refer to.
+         */
+        std::chrono::system_clock::time_point m_now;
+
+        /**
+         * The offset from UTC in seconds for each hour since the epoch.
+         * Only changes with daylight saving time, so there are few distinct values.
+         */
+        std::unordered_map<std::int64_t, std::int32_t> m_utcOffsets;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        Slot& Format(std::size_t t_index, const Entry& t_entry);
+
+        char* FormatSize(char* t_first, char* t_last, std::uint64_t t_bytes) const;
+        char* FormatTime(char* t_first, char* t_last, std::filesystem::file_time_type t_fileTime);
+
+        std::int32_t GetUtcOffset(std::chrono::sys_seconds t_time);
+
+        void Clear();
+    };
+}
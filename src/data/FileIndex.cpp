@@ -0,0 +1,700 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include <ranges>
+#include <optional>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include "FileIndex.h"
+#include "Collation.h"
+#include "ListingCache.h"
+#include "application/Util.h"
+#include "Log.h"
+#include "IcProfile.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include "GetdentsReader.h"
+#endif
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::FileIndex::FileIndex()
+{
+    IC_LOG_DEBUG("[FileIndex::FileIndex()] Create FileIndex.");
+}
+
+ic::data::FileIndex::~FileIndex() noexcept
+{
+    IC_LOG_DEBUG("[FileIndex::~FileIndex()] Destruct FileIndex.");
+
+    // the jthread destructor requests a stop and joins
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+std::filesystem::path ic::data::FileIndex::GetRoot() const
+{
+    std::shared_lock lock{ m_mutex };
+
+    return m_root;
+}
+
+std::size_t ic::data::FileIndex::GetSize() const
+{
+    std::shared_lock lock{ m_mutex };
+
+    // the root is not counted
+    return m_nodes.empty() ? 0 : m_nodes.size() - 1 - m_deleted;
+}
+
+std::filesystem::path ic::data::FileIndex::GetPath(const std::uint32_t t_node) const
+{
+    std::shared_lock lock{ m_mutex };
+
+    return t_node < m_nodes.size() ? GetPathUnlocked(t_node) : std::filesystem::path();
+}
+
+bool ic::data::FileIndex::IsDirectory(const std::uint32_t t_node) const
+{
+    std::shared_lock lock{ m_mutex };
+
+    return t_node < m_nodes.size() && (m_nodes[t_node].flags & DIRECTORY);
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::FileIndex::Build(const std::filesystem::path& t_root)
+{
+    // requests a stop and joins
+    m_thread = {};
+
+    {
+        std::unique_lock lock{ m_mutex };
+        Clear(t_root);
+    }
+
+    m_running = true;
+    m_thread = std::jthread([this, t_root](const std::stop_token& t_stopToken) {
+        Run(t_stopToken, t_root);
+    });
+}
+
+void ic::data::FileIndex::Refresh()
+{
+    if (m_running || GetRoot().empty())
+    {
+        return;
+    }
+
+    m_thread = {};
+    m_running = true;
+    m_thread = std::jthread([this](const std::stop_token& t_stopToken) {
+        RunRefresh(t_stopToken);
+    });
+}
+
+std::vector<ic::data::FileIndex::Match> ic::data::FileIndex::Find(const std::string_view t_query) const
+{
+    const auto query{ Collation::FoldCase(t_query) };
+    if (query.empty())
+    {
+        return {};
+    }
+
+    const auto mask{ Mask(query) };
+
+    std::shared_lock lock{ m_mutex };
+
+    // the root is never a match
+    const auto size{ static_cast<std::uint32_t>(m_nodes.size()) };
+    const auto parts{ std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), size / PARALLEL_MIN_NODES) };
+
+    std::vector<Match> matches;
+    if (parts < 2)
+    {
+        FindRange(query, mask, 1, size, matches);
+    }
+    else
+    {
+        std::vector<std::vector<Match>> partMatches(parts);
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(parts);
+            for (std::size_t part{ 0 }; part < parts; ++part)
+            {
+                workers.emplace_back([&, part] {
+                    FindRange(
+                        query, mask,
+                        std::max(1u, static_cast<std::uint32_t>(size * part / parts)),
+                        static_cast<std::uint32_t>(size * (part + 1) / parts),
+                        partMatches[part]
+                    );
+                });
+            }
+        }
+
+        for (const auto& part : partMatches)
+        {
+            matches.insert(matches.end(), part.begin(), part.end());
+        }
+    }
+
+    std::ranges::sort(matches, IsBetter);
+    if (matches.size() > MAX_MATCHES)
+    {
+        matches.resize(MAX_MATCHES);
+    }
+
+    return matches;
+}
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::FileIndex::Run(const std::stop_token& t_stopToken, const std::filesystem::path& t_root)
+{
+    IC_LOG_DEBUG("[FileIndex::Run()] Start indexing {}.", t_root.string());
+
+    const auto start{ std::chrono::steady_clock::now() };
+
+    Walk(t_stopToken, { { 0, t_root } });
+
+    IC_LOG_DEBUG("[FileIndex::Run()] Indexed {} paths in {} ms.",
+        GetSize(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+    m_running = false;
+}
+
+void ic::data::FileIndex::RunRefresh(const std::stop_token& t_stopToken)
+{
+    std::vector<std::pair<std::size_t, std::filesystem::path>> directories;
+    std::filesystem::path root;
+    {
+        std::shared_lock lock{ m_mutex };
+        root = m_root;
+        directories.reserve(m_directories.size());
+        for (std::size_t i{ 0 }; i < m_directories.size(); ++i)
+        {
+            if (!(m_nodes[m_directories[i].node].flags & DELETED))
+            {
+                directories.emplace_back(i, GetPathUnlocked(m_directories[i].node));
+            }
+        }
+    }
+
+    // a stat per directory is much cheaper than reading it
+    struct Changed
+    {
+        std::size_t directory;
+        std::uint32_t node;
+        std::int64_t modificationTime;
+        std::filesystem::path path;
+        std::vector<Child> children;
+    };
+
+    std::vector<Changed> changed;
+    for (auto& [directory, path] : directories)
+    {
+        if (t_stopToken.stop_requested())
+        {
+            m_running = false;
+            return;
+        }
+
+        // a removed directory is handled by its parent, whose modify time has changed too
+        const auto stamp{ DirectoryStamp::Read(path) };
+        std::shared_lock lock{ m_mutex };
+        if (stamp && stamp->modificationTime != m_directories[directory].modificationTime)
+        {
+            changed.push_back({ directory, m_directories[directory].node, stamp->modificationTime, std::move(path), {} });
+        }
+    }
+
+    IC_LOG_DEBUG("[FileIndex::RunRefresh()] {} of {} directories have changed.", changed.size(), directories.size());
+
+    if (changed.size() > MAX_CHANGED_DIRECTORIES)
+    {
+        {
+            std::unique_lock lock{ m_mutex };
+            Clear(root);
+        }
+
+        Run(t_stopToken, root);
+
+        return;
+    }
+
+    std::erase_if(changed, [](Changed& t_changed) {
+        return !ReadDirectory(t_changed.path, t_changed.children);
+    });
+
+    std::vector<Pending> pending;
+    {
+        std::unique_lock lock{ m_mutex };
+
+        // one pass over all nodes finds the current children of the changed directories
+        std::unordered_map<std::uint32_t, std::size_t> changedNodes;
+        for (std::size_t i{ 0 }; i < changed.size(); ++i)
+        {
+            changedNodes.emplace(changed[i].node, i);
+        }
+
+        std::vector<std::unordered_map<std::string_view, std::uint32_t>> existing(changed.size());
+        for (std::uint32_t node{ 1 }; node < m_nodes.size(); ++node)
+        {
+            if (const auto it{ changedNodes.find(m_nodes[node].parent) }; it != changedNodes.end() && !(m_nodes[node].flags & DELETED))
+            {
+                existing[it->second].emplace(GetName(node), node);
+            }
+        }
+
+        // the names are views into m_names: nodes are only added after all lookups
+        std::vector<std::pair<std::size_t, const Child*>> added;
+        for (std::size_t i{ 0 }; i < changed.size(); ++i)
+        {
+            for (const auto& child : changed[i].children)
+            {
+                if (const auto it{ existing[i].find(child.name) };
+                    it != existing[i].end() && static_cast<bool>(m_nodes[it->second].flags & DIRECTORY) == child.directory)
+                {
+                    existing[i].erase(it);
+                }
+                else
+                {
+                    added.emplace_back(i, &child);
+                }
+            }
+
+            for (const auto& node : existing[i] | std::views::values)
+            {
+                m_nodes[node].flags |= DELETED;
+                ++m_deleted;
+            }
+
+            m_directories[changed[i].directory].modificationTime = changed[i].modificationTime;
+        }
+
+        for (const auto& [i, child] : added)
+        {
+            const auto node{ AddNode(changed[i].node, child->name, child->directory) };
+            if (child->directory)
+            {
+                pending.push_back({ node, changed[i].path / child->name });
+            }
+        }
+
+        // parents are stored first: one pass removes the descendants of removed directories
+        for (auto& node : m_nodes)
+        {
+            if (node.parent != NO_PARENT && !(node.flags & DELETED) && (m_nodes[node.parent].flags & DELETED))
+            {
+                node.flags |= DELETED;
+                ++m_deleted;
+            }
+        }
+
+        IC_LOG_DEBUG("[FileIndex::RunRefresh()] Added {} paths, {} paths removed in total.", added.size(), m_deleted);
+    }
+
+    Walk(t_stopToken, std::move(pending));
+
+    m_running = false;
+}
+
+void ic::data::FileIndex::Walk(const std::stop_token& t_stopToken, std::vector<Pending> t_pending)
+{
+    std::mutex queueMutex;
+    std::condition_variable_any condition;
+    std::size_t active{ 0 };
+
+    auto worker{ [&] {
+        application::Util::LowerThreadPriority();
+
+        std::vector<Child> children;
+        std::vector<std::uint32_t> nodes;
+        std::vector<Pending> subdirectories;
+
+        while (true)
+        {
+            Pending directory;
+            {
+                std::unique_lock lock{ queueMutex };
+
+                // the walk is finished when no directory is pending and no worker can add one
+                condition.wait(lock, t_stopToken, [&] { return !t_pending.empty() || active == 0; });
+                if (t_stopToken.stop_requested() || t_pending.empty())
+                {
+                    return;
+                }
+
+                directory = std::move(t_pending.back());
+                t_pending.pop_back();
+                ++active;
+            }
+
+            children.clear();
+            nodes.clear();
+            subdirectories.clear();
+
+            // the stamp is read first, so that changes while reading are found by a refresh
+            const auto stamp{ application::Util::IsPseudoFileSystem(directory.path) ? std::nullopt : DirectoryStamp::Read(directory.path) };
+            if (stamp && ReadDirectory(directory.path, children))
+            {
+                std::unique_lock lock{ m_mutex };
+                m_directories.push_back({ directory.node, stamp->modificationTime });
+                for (const auto& child : children)
+                {
+                    nodes.push_back(AddNode(directory.node, child.name, child.directory));
+                }
+            }
+
+            for (std::size_t i{ 0 }; i < nodes.size(); ++i)
+            {
+                if (children[i].directory)
+                {
+                    subdirectories.push_back({ nodes[i], directory.path / children[i].name });
+                }
+            }
+
+            {
+                std::scoped_lock lock{ queueMutex };
+                std::ranges::move(subdirectories, std::back_inserter(t_pending));
+                --active;
+            }
+
+            condition.notify_all();
+        }
+    } };
+
+    const auto count{ std::clamp(std::thread::hardware_concurrency(), 1u, 8u) };
+    std::vector<std::jthread> threads;
+    threads.reserve(count);
+    for (auto i{ 0u }; i < count; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+}
+
+void ic::data::FileIndex::Clear(const std::filesystem::path& t_root)
+{
+    m_root = t_root;
+    m_nodes.clear();
+    m_masks.clear();
+    m_names.clear();
+    m_foldedNames.clear();
+    m_directories.clear();
+    m_deleted = 0;
+
+    // the name of the root is the whole path
+    AddNode(NO_PARENT, t_root.string(), true);
+}
+
+std::uint32_t ic::data::FileIndex::AddNode(const std::uint32_t t_parent, const std::string_view t_name, const bool t_directory)
+{
+    const auto node{ static_cast<std::uint32_t>(m_nodes.size()) };
+    std::uint8_t flags{ t_directory ? std::uint8_t{ DIRECTORY } : std::uint8_t{ 0 } };
+
+    // ASCII names are converted to lower case while they are scored
+    auto mask{ Mask(t_name) };
+    if (std::ranges::any_of(t_name, [](const char t_c) { return static_cast<unsigned char>(t_c) >= 0x80; }))
+    {
+        auto folded{ Collation::FoldCase(t_name) };
+        mask = Mask(folded);
+        if (!std::ranges::equal(folded, t_name, {}, {}, [](const char t_c) {
+            return t_c >= 'A' && t_c <= 'Z' ? static_cast<char>(t_c + ('a' - 'A')) : t_c;
+        }))
+        {
+            flags |= FOLDED;
+            m_foldedNames.emplace(node, std::move(folded));
+        }
+    }
+
+    m_nodes.push_back({ t_parent, static_cast<std::uint32_t>(m_names.size()), static_cast<std::uint16_t>(t_name.size()), flags });
+    m_masks.push_back(mask);
+    m_names.insert(m_names.end(), t_name.begin(), t_name.end());
+
+    return node;
+}
+
+void ic::data::FileIndex::FindRange(
+    const std::string_view t_query,
+    const std::uint64_t t_mask,
+    const std::uint32_t t_begin,
+    const std::uint32_t t_end,
+    std::vector<Match>& t_matches
+) const
+{
+    // the heap keeps the worst of the best matches in front
+    t_matches.reserve(MAX_MATCHES);
+
+    for (auto node{ t_begin }; node < t_end; ++node)
+    {
+        if ((m_masks[node] & t_mask) != t_mask || (m_nodes[node].flags & DELETED))
+        {
+            continue;
+        }
+
+        const auto name{ m_nodes[node].flags & FOLDED ? std::string_view(m_foldedNames.at(node)) : GetName(node) };
+        const auto score{ Score(name, t_query) };
+        if (score < 0)
+        {
+            continue;
+        }
+
+        // the depth is only needed for the few paths that can make it into the heap
+        if (t_matches.size() == MAX_MATCHES && score < t_matches.front().score)
+        {
+            continue;
+        }
+
+        const Match match{ node, score, GetDepth(node) };
+        if (t_matches.size() < MAX_MATCHES)
+        {
+            t_matches.push_back(match);
+            std::ranges::push_heap(t_matches, IsBetter);
+        }
+        else if (IsBetter(match, t_matches.front()))
+        {
+            std::ranges::pop_heap(t_matches, IsBetter);
+            t_matches.back() = match;
+            std::ranges::push_heap(t_matches, IsBetter);
+        }
+    }
+}
+
+std::string_view ic::data::FileIndex::GetName(const std::uint32_t t_node) const
+{
+    const auto& node{ m_nodes[t_node] };
+
+    return { m_names.data() + node.name, node.length };
+}
+
+std::uint32_t ic::data::FileIndex::GetDepth(const std::uint32_t t_node) const
+{
+    std::uint32_t depth{ 0 };
+    for (auto node{ t_node }; m_nodes[node].parent != NO_PARENT; node = m_nodes[node].parent)
+    {
+        ++depth;
+    }
+
+    return depth;
+}
+
+std::filesystem::path ic::data::FileIndex::GetPathUnlocked(const std::uint32_t t_node) const
+{
+    std::vector<std::uint32_t> nodes;
+    for (auto node{ t_node }; m_nodes[node].parent != NO_PARENT; node = m_nodes[node].parent)
+    {
+        nodes.push_back(node);
+    }
+
+    auto path{ m_root };
+    for (const auto node : nodes | std::views::reverse)
+    {
+        path /= GetName(node);
+    }
+
+    return path;
+}
+
+bool ic::data::FileIndex::ReadDirectory(const std::filesystem::path& t_path, std::vector<Child>& t_children)
+{
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    GetdentsReader reader{ t_path, READ_BUFFER_SIZE };
+    if (!reader.IsOpen())
+    {
+        return false;
+    }
+
+    // symbolic links are not followed
+    while (reader.Read([&](const std::string_view t_name, const unsigned char t_type) {
+        auto directory{ t_type == DT_DIR };
+        if (t_type == DT_UNKNOWN)
+        {
+            struct stat st{};
+            directory = IC_PROFILE_FS(FSTATAT, "FileIndex::ReadDirectory", fstatat(reader.GetFd(), t_name.data(), &st, AT_SYMLINK_NOFOLLOW)) == 0 && S_ISDIR(st.st_mode);
+        }
+
+        t_children.push_back({ std::string(t_name), directory });
+    }))
+    {
+    }
+
+    return true;
+#else
+    std::error_code ec;
+    std::filesystem::directory_iterator it{ t_path, std::filesystem::directory_options::skip_permission_denied, ec };
+    if (ec)
+    {
+        return false;
+    }
+
+    // symbolic links and junctions are not followed
+    for (const std::filesystem::directory_iterator end; !ec && it != end; it.increment(ec))
+    {
+        const auto status{ it->symlink_status(ec) };
+        t_children.push_back({ it->path().filename().string(), !ec && std::filesystem::is_directory(status) });
+    }
+
+    return true;
+#endif
+}
+
+bool ic::data::FileIndex::IsBetter(const Match& t_lhs, const Match& t_rhs)
+{
+    if (t_lhs.score != t_rhs.score)
+    {
+        return t_lhs.score > t_rhs.score;
+    }
+
+    return t_lhs.depth != t_rhs.depth ? t_lhs.depth < t_rhs.depth : t_lhs.node < t_rhs.node;
+}
+
+std::uint64_t ic::data::FileIndex::Mask(const std::string_view t_folded)
+{
+    std::uint64_t mask{ 0 };
+    for (const auto c : t_folded)
+    {
+        const auto byte{ static_cast<unsigned char>(c) };
+        unsigned bit;
+        if (byte >= 'a' && byte <= 'z')
+        {
+            bit = byte - 'a';
+        }
+        else if (byte >= 'A' && byte <= 'Z')
+        {
+            bit = byte - 'A';
+        }
+        else if (byte >= '0' && byte <= '9')
+        {
+            bit = 26 + (byte - '0');
+        }
+        else
+        {
+            bit = 36 + byte % 28;
+        }
+
+        mask |= std::uint64_t{ 1 } << bit;
+    }
+
+    return mask;
+}
+
+std::int32_t ic::data::FileIndex::Score(const std::string_view t_name, const std::string_view t_query)
+{
+    static constexpr std::int32_t SCORE_MATCH{ 16 };
+    static constexpr std::int32_t BONUS_CONSECUTIVE{ 8 };
+    static constexpr std::int32_t BONUS_BOUNDARY{ 8 };
+    static constexpr std::int32_t BONUS_FIRST{ 12 };
+    static constexpr std::int32_t BONUS_EXACT{ 16 };
+    static constexpr std::int32_t PENALTY_GAP_START{ 3 };
+    static constexpr std::int32_t PENALTY_GAP{ 1 };
+
+    const auto lower{ [](const char t_c) {
+        return t_c >= 'A' && t_c <= 'Z' ? static_cast<char>(t_c + ('a' - 'A')) : t_c;
+    } };
+
+    const auto isBoundary{ [](const char t_previous, const char t_c) {
+        return t_previous == ' ' || t_previous == '_' || t_previous == '-' || t_previous == '.' ||
+            (t_previous >= 'a' && t_previous <= 'z' && t_c >= 'A' && t_c <= 'Z');
+    } };
+
+    const auto n{ t_name.size() };
+    const auto m{ t_query.size() };
+    if (m > n)
+    {
+        return -1;
+    }
+
+    // the first match ...
+    std::size_t q{ 0 };
+    std::size_t end{ 0 };
+    for (std::size_t i{ 0 }; i < n; ++i)
+    {
+        if (lower(t_name[i]) == t_query[q] && ++q == m)
+        {
+            end = i;
+            break;
+        }
+    }
+
+    if (q < m)
+    {
+        return -1;
+    }
+
+    // ... is shortened from its end
+    std::size_t start{ end };
+    for (auto i{ end + 1 }; i-- > 0;)
+    {
+        if (lower(t_name[i]) == t_query[q - 1] && --q == 0)
+        {
+            start = i;
+            break;
+        }
+    }
+
+    std::int32_t score{ 0 };
+    auto consecutive{ false };
+    for (auto i{ start }; i <= end && q < m; ++i)
+    {
+        if (lower(t_name[i]) == t_query[q])
+        {
+            score += SCORE_MATCH;
+            if (consecutive)
+            {
+                score += BONUS_CONSECUTIVE;
+            }
+            if (i == 0)
+            {
+                score += BONUS_FIRST;
+            }
+            else if (isBoundary(t_name[i - 1], t_name[i]))
+            {
+                score += BONUS_BOUNDARY;
+            }
+
+            consecutive = true;
+            ++q;
+        }
+        else
+        {
+            score -= consecutive ? PENALTY_GAP_START : PENALTY_GAP;
+            consecutive = false;
+        }
+    }
+
+    if (m == n)
+    {
+        score += BONUS_EXACT;
+    }
+
+    // shorter names first
+    return std::max(score - static_cast<std::int32_t>(std::min<std::size_t>(n - m, 64) / 4), 0);
+}
@@ -0,0 +1,233 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+namespace ic::data
+{
+    /**
+     * An index of all paths under a root directory for the "jump to file" finder.
+     * The index is built by a parallel walker in the background and can be searched
+     * while it grows. Each path is a node with the index of its parent directory
+     * and its name, so a path costs 20 bytes plus the length of its name.
+     */
+    class FileIndex
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Match
+        {
+            std::uint32_t node;
+            std::int32_t score;
+
+            // paths closer to the root come first if the scores are equal
+            std::uint32_t depth;
+        };
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The maximum number of matches returned by a search.
+         */
+        static constexpr std::size_t MAX_MATCHES{ 100 };
+
+        /**
+         * If more directories have changed, a refresh rebuilds the index.
+         */
+        static constexpr std::size_t MAX_CHANGED_DIRECTORIES{ 256 };
+
+        /**
+         * Larger indexes are searched in parallel, each thread gets at least this number of paths.
+         */
+        static constexpr std::size_t PARALLEL_MIN_NODES{ 256 * 1024 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        FileIndex();
+
+        FileIndex(const FileIndex& t_other) = delete;
+        FileIndex(FileIndex&& t_other) noexcept = delete;
+        FileIndex& operator=(const FileIndex& t_other) = delete;
+        FileIndex& operator=(FileIndex&& t_other) noexcept = delete;
+
+        ~FileIndex() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsRunning() const { return m_running; }
+        [[nodiscard]] std::filesystem::path GetRoot() const;
+
+        /**
+         * @return The number of indexed paths.
+         */
+        [[nodiscard]] std::size_t GetSize() const;
+
+        [[nodiscard]] std::filesystem::path GetPath(std::uint32_t t_node) const;
+        [[nodiscard]] bool IsDirectory(std::uint32_t t_node) const;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Discards the index and starts indexing another root directory.
+         *
+         * @param t_root The root directory.
+         */
+        void Build(const std::filesystem::path& t_root);
+
+        /**
+         * Re-reads the directories whose modify time has changed in the background.
+         * Does nothing while the index is built or refreshed.
+         */
+        void Refresh();
+
+        /**
+         * Searches the names of all indexed paths for the characters of the query in the
+         * given order. Consecutive characters and characters at the start of words score higher.
+         *
+         * @param t_query The query.
+         *
+         * @return The best matches, the best match first.
+         */
+        [[nodiscard]] std::vector<Match> Find(std::string_view t_query) const;
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        enum Flag : std::uint8_t
+        {
+            DIRECTORY = 1,
+            DELETED = 2,
+
+            // the name has a case-folded copy in m_foldedNames
+            FOLDED = 4
+        };
+
+        struct Node
+        {
+            std::uint32_t parent;
+            std::uint32_t name;
+            std::uint16_t length;
+            std::uint8_t flags;
+        };
+
+        struct Directory
+        {
+            std::uint32_t node;
+            std::int64_t modificationTime;
+        };
+
+        struct Child
+        {
+            std::string name;
+            bool directory;
+        };
+
+        struct Pending
+        {
+            std::uint32_t node;
+            std::filesystem::path path;
+        };
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::uint32_t NO_PARENT{ UINT32_MAX };
+
+        /**
+         * Most directories are small, a smaller buffer than the scanner's is enough.
+         */
+        static constexpr std::size_t READ_BUFFER_SIZE{ 64 * 1024 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        mutable std::shared_mutex m_mutex;
+
+        std::filesystem::path m_root;
+
+        /**
+         * Parents are always stored before their children, the root is the first node.
+         */
+        std::vector<Node> m_nodes;
+
+        /**
+         * A bit for each character of the case-folded name, checked before a name is scored.
+         */
+        std::vector<std::uint64_t> m_masks;
+
+        std::vector<char> m_names;
+
+        /**
+         * Names that need more than an ASCII lower case conversion.
+         */
+        std::unordered_map<std::uint32_t, std::string> m_foldedNames;
+
+        std::vector<Directory> m_directories;
+        std::size_t m_deleted{ 0 };
+
+        std::atomic_bool m_running{ false };
+        std::jthread m_thread;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void Run(const std::stop_token& t_stopToken, const std::filesystem::path& t_root);
+        void RunRefresh(const std::stop_token& t_stopToken);
+        void Walk(const std::stop_token& t_stopToken, std::vector<Pending> t_pending);
+        void Clear(const std::filesystem::path& t_root);
+
+        std::uint32_t AddNode(std::uint32_t t_parent, std::string_view t_name, bool t_directory);
+        void FindRange(std::string_view t_query, std::uint64_t t_mask, std::uint32_t t_begin, std::uint32_t t_end, std::vector<Match>& t_matches) const;
+        [[nodiscard]] std::string_view GetName(std::uint32_t t_node) const;
+        [[nodiscard]] std::uint32_t GetDepth(std::uint32_t t_node) const;
+        [[nodiscard]] std::filesystem::path GetPathUnlocked(std::uint32_t t_node) const;
+
+        static bool ReadDirectory(const std::filesystem::path& t_path, std::vector<Child>& t_children);
+        [[nodiscard]] static bool IsBetter(const Match& t_lhs, const Match& t_rhs);
+        [[nodiscard]] static std::uint64_t Mask(std::string_view t_folded);
+        [[nodiscard]] static std::int32_t Score(std::string_view t_name, std::string_view t_query);
+    };
+}
@@ -0,0 +1,93 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "GetdentsReader.h"
+#include "IcProfile.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <cerrno>
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::GetdentsReader::GetdentsReader(const std::filesystem::path& t_path, const std::size_t t_bufferSize)
+    : m_fd{ IC_PROFILE_FS(OPEN, "GetdentsReader::GetdentsReader", open(t_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) }
+{
+    if (m_fd < 0)
+    {
+        m_error = errno;
+    }
+    else
+    {
+        m_buffer.resize(t_bufferSize);
+    }
+}
+
+ic::data::GetdentsReader::GetdentsReader(const int t_directoryFd, const char* t_name, const std::size_t t_bufferSize)
+    : m_fd{ IC_PROFILE_FS(OPEN, "GetdentsReader::GetdentsReader", openat(t_directoryFd, t_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)) }
+{
+    if (m_fd < 0)
+    {
+        m_error = errno;
+    }
+    else
+    {
+        m_buffer.resize(t_bufferSize);
+    }
+}
+
+ic::data::GetdentsReader::~GetdentsReader() noexcept
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+long ic::data::GetdentsReader::Fill()
+{
+    if (m_fd < 0)
+    {
+        return -1;
+    }
+
+    long bytes;
+    do
+    {
+        bytes = IC_PROFILE_FS(GETDENTS, "GetdentsReader::Fill", syscall(SYS_getdents64, m_fd, m_buffer.data(), m_buffer.size()));
+    }
+    while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0)
+    {
+        m_error = errno;
+    }
+
+    return bytes;
+}
+
+#endif
@@ -0,0 +1,164 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <dirent.h>
+
+namespace ic::data
+{
+    /**
+     * Reads a directory with the getdents64 syscall into a large buffer.
+     * Unlike std::filesystem::directory_iterator, no path is allocated per entry
+     * and the d_type of each entry is available.
+     */
+    class GetdentsReader
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::size_t BUFFER_SIZE{ 1024 * 1024 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        GetdentsReader() = delete;
+
+        /**
+         * Opens a directory.
+         *
+         * @param t_path The directory.
+         * @param t_bufferSize The size of the buffer filled by one getdents64 call.
+         */
+        explicit GetdentsReader(const std::filesystem::path& t_path, std::size_t t_bufferSize = BUFFER_SIZE);
+
+        /**
+         * Opens a directory relative to an open directory. A symlink is not followed.
+         *
+         * @param t_directoryFd The open directory or AT_FDCWD.
+         * @param t_name The name or path of the directory.
+         * @param t_bufferSize The size of the buffer filled by one getdents64 call.
+         */
+        GetdentsReader(int t_directoryFd, const char* t_name, std::size_t t_bufferSize = BUFFER_SIZE);
+
+        GetdentsReader(const GetdentsReader& t_other) = delete;
+        GetdentsReader(GetdentsReader&& t_other) noexcept = delete;
+        GetdentsReader& operator=(const GetdentsReader& t_other) = delete;
+        GetdentsReader& operator=(GetdentsReader&& t_other) noexcept = delete;
+
+        ~GetdentsReader() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsOpen() const { return m_fd >= 0; }
+        [[nodiscard]] int GetFd() const { return m_fd; }
+        [[nodiscard]] int GetError() const { return m_error; }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Keeps the directory open after the reader is destroyed.
+         *
+         * @return The file descriptor, which must be closed by the caller.
+         */
+        [[nodiscard]] int Release() { return std::exchange(m_fd, -1); }
+
+        /**
+         * Fills the buffer with the next entries and calls t_callback(name, d_type)
+         * for each of them. The entries "." and ".." are skipped.
+         *
+         * @param t_callback Receives the name and the d_type of each entry.
+         *
+         * @return False if there are no more entries or an error occurred.
+         */
+        template <typename Callback>
+        bool Read(Callback&& t_callback)
+        {
+            const auto bytes{ Fill() };
+            if (bytes <= 0)
+            {
+                return false;
+            }
+
+            for (long offset{ 0 }; offset < bytes;)
+            {
+                const auto* dirent{ reinterpret_cast<const Dirent64*>(m_buffer.data() + offset) };
+                offset += dirent->d_reclen;
+
+                const std::string_view name{ dirent->d_name };
+                if (name == "." || name == "..")
+                {
+                    continue;
+                }
+
+                t_callback(name, dirent->d_type);
+            }
+
+            return true;
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * The record layout of getdents64; glibc does not export it.
+         */
+        struct Dirent64
+        {
+            std::uint64_t d_ino;
+            std::int64_t d_off;
+            unsigned short d_reclen;
+            unsigned char d_type;
+            char d_name[];
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        int m_fd{ -1 };
+        int m_error{ 0 };
+        std::vector<char> m_buffer;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        long Fill();
+    };
+}
+
+#endif
@@ -0,0 +1,195 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "ListingCache.h"
+#include "IcProfile.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <sys/stat.h>
+#endif
+
+//-------------------------------------------------
+// DirectoryStamp
+//-------------------------------------------------
+
+std::optional<ic::data::DirectoryStamp> ic::data::DirectoryStamp::Read(const std::filesystem::path& t_path)
+{
+    DirectoryStamp stamp;
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    struct stat st{};
+    if (IC_PROFILE_FS(STAT, "DirectoryStamp::Read", stat(t_path.c_str(), &st)) != 0)
+    {
+        return std::nullopt;
+    }
+
+    stamp.device = st.st_dev;
+    stamp.inode = st.st_ino;
+    stamp.modificationTime = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+#else
+    std::error_code ec;
+    const auto lastWrite{ IC_PROFILE_FS(STAT, "DirectoryStamp::Read", std::filesystem::last_write_time(t_path, ec)) };
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    stamp.modificationTime = lastWrite.time_since_epoch().count();
+#endif
+
+    return stamp;
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+ic::data::ListingCache::Stats ic::data::ListingCache::GetStats() const
+{
+    std::scoped_lock lock{ m_mutex };
+
+    return { m_hits, m_misses, m_items.size(), m_bytes, m_budget };
+}
+
+//-------------------------------------------------
+// Setter
+//-------------------------------------------------
+
+void ic::data::ListingCache::SetBudget(const std::size_t t_bytes)
+{
+    std::scoped_lock lock{ m_mutex };
+
+    m_budget = t_bytes;
+    Evict();
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::ListingCache::Put(const std::filesystem::path& t_path, Listing&& t_listing)
+{
+    const auto bytes{ SizeOf(t_listing) };
+
+    std::scoped_lock lock{ m_mutex };
+
+    if (const auto it{ m_index.find(t_path.native()) }; it != m_index.end())
+    {
+        Erase(it->second);
+    }
+
+    if (bytes > m_budget)
+    {
+        return;
+    }
+
+    m_items.push_front({ t_path, std::move(t_listing), bytes });
+    m_index.emplace(t_path.native(), m_items.begin());
+    m_bytes += bytes;
+
+    Evict();
+}
+
+bool ic::data::ListingCache::TryPut(const std::filesystem::path& t_path, Listing&& t_listing)
+{
+    const auto bytes{ SizeOf(t_listing) };
+
+    std::scoped_lock lock{ m_mutex };
+
+    if (m_index.contains(t_path.native()))
+    {
+        return true;
+    }
+
+    if (m_bytes + bytes > m_budget)
+    {
+        return false;
+    }
+
+    // at the end: a listing that was never visited is evicted first
+    m_items.push_back({ t_path, std::move(t_listing), bytes });
+    m_index.emplace(t_path.native(), std::prev(m_items.end()));
+    m_bytes += bytes;
+
+    return true;
+}
+
+bool ic::data::ListingCache::Take(const std::filesystem::path& t_path, Listing& t_listing)
+{
+    std::scoped_lock lock{ m_mutex };
+
+    const auto it{ m_index.find(t_path.native()) };
+    if (it == m_index.end())
+    {
+        ++m_misses;
+        return false;
+    }
+
+    t_listing = std::move(it->second->listing);
+    Erase(it->second);
+    ++m_hits;
+
+    return true;
+}
+
+void ic::data::ListingCache::Remove(const std::filesystem::path& t_path)
+{
+    std::scoped_lock lock{ m_mutex };
+
+    if (const auto it{ m_index.find(t_path.native()) }; it != m_index.end())
+    {
+        Erase(it->second);
+    }
+}
+
+bool ic::data::ListingCache::Contains(const std::filesystem::path& t_path) const
+{
+    std::scoped_lock lock{ m_mutex };
+
+    return m_index.contains(t_path.native());
+}
+
+std::size_t ic::data::ListingCache::SizeOf(const Listing& t_listing)
+{
+    auto bytes{ sizeof(Listing) + t_listing.filesAndDirs.capacity() * sizeof(Entry) + t_listing.rows.capacity() * sizeof(Row) };
+    for (const auto& entry : t_listing.filesAndDirs)
+    {
+        bytes += entry.path.native().capacity() + entry.name.capacity() + entry.sortKey.capacity() + entry.naturalKey.capacity();
+    }
+
+    return bytes;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::ListingCache::Erase(const std::list<Item>::iterator t_it)
+{
+    m_bytes -= t_it->bytes;
+    m_index.erase(t_it->path.native());
+    m_items.erase(t_it);
+}
+
+void ic::data::ListingCache::Evict()
+{
+    while (m_bytes > m_budget && !m_items.empty())
+    {
+        Erase(std::prev(m_items.end()));
+    }
+}
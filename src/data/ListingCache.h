@@ -0,0 +1,215 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include "Entry.h"
+#include "Entries.h"
+
+namespace ic::data
+{
+    /**
+     * Identifies the state of a directory. Creating, deleting or renaming
+     * an entry changes the modification time of its directory.
+     */
+    struct DirectoryStamp
+    {
+        std::uint64_t device{ 0 };
+        std::uint64_t inode{ 0 };
+        std::int64_t modificationTime{ 0 };
+
+        bool operator==(const DirectoryStamp& t_other) const = default;
+
+        /**
+         * Reads the stamp of a directory.
+         *
+         * @param t_path The directory.
+         *
+         * @return The stamp or nothing if the directory cannot be read.
+         */
+        [[nodiscard]] static std::optional<DirectoryStamp> Read(const std::filesystem::path& t_path);
+    };
+
+    /**
+     * A directory listing as it is stored in the cache.
+     */
+    struct Listing
+    {
+        DirectoryStamp stamp;
+        std::vector<Entry> filesAndDirs;
+        std::vector<Row> rows;
+        SortSpec sortSpec;
+    };
+
+    /**
+     * Keeps the recently used directory listings within a memory budget.
+     * The least recently used listings are evicted first.
+     */
+    class ListingCache
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Stats
+        {
+            std::size_t hits{ 0 };
+            std::size_t misses{ 0 };
+            std::size_t listings{ 0 };
+            std::size_t bytes{ 0 };
+            std::size_t budget{ 0 };
+        };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        ListingCache() = default;
+
+        ListingCache(const ListingCache& t_other) = delete;
+        ListingCache(ListingCache&& t_other) noexcept = delete;
+        ListingCache& operator=(const ListingCache& t_other) = delete;
+        ListingCache& operator=(ListingCache&& t_other) noexcept = delete;
+
+        ~ListingCache() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] Stats GetStats() const;
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * Sets the memory budget and evicts listings if necessary.
+         *
+         * @param t_bytes The budget in bytes.
+         */
+        void SetBudget(std::size_t t_bytes);
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Stores a listing. A listing for the same path is replaced.
+         * Can be called from any thread.
+         *
+         * @param t_path The directory.
+         * @param t_listing The listing.
+         */
+        void Put(const std::filesystem::path& t_path, Listing&& t_listing);
+
+        /**
+         * Stores a listing only if it fits into the budget without evicting others.
+         * Can be called from any thread.
+         *
+         * @param t_path The directory.
+         * @param t_listing The listing.
+         *
+         * @return False if the budget is exhausted.
+         */
+        bool TryPut(const std::filesystem::path& t_path, Listing&& t_listing);
+
+        /**
+         * Removes a listing from the cache and returns it. The stamp is not checked here,
+         * because reading it may block: the caller validates the listing in the background.
+         *
+         * @param t_path The directory.
+         * @param t_listing Receives the listing.
+         *
+         * @return True on a cache hit.
+         */
+        bool Take(const std::filesystem::path& t_path, Listing& t_listing);
+
+        /**
+         * Discards the listing of a directory.
+         *
+         * @param t_path The directory.
+         */
+        void Remove(const std::filesystem::path& t_path);
+
+        /**
+         * Checks if there is a listing of the given directory.
+         *
+         * @param t_path The directory.
+         *
+         * @return True if the directory is cached.
+         */
+        [[nodiscard]] bool Contains(const std::filesystem::path& t_path) const;
+
+        /**
+         * Estimates the memory used by a listing.
+         *
+         * @param t_listing The listing.
+         *
+         * @return The size in bytes.
+         */
+        [[nodiscard]] static std::size_t SizeOf(const Listing& t_listing);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Item
+        {
+            std::filesystem::path path;
+            Listing listing;
+            std::size_t bytes{ 0 };
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        mutable std::mutex m_mutex;
+
+        /**
+         * The listings, most recently used first.
+         */
+        std::list<Item> m_items;
+
+        std::unordered_map<std::filesystem::path::string_type, std::list<Item>::iterator> m_index;
+
+        std::size_t m_bytes{ 0 };
+        std::size_t m_budget{ 0 };
+        std::size_t m_hits{ 0 };
+        std::size_t m_misses{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void Erase(std::list<Item>::iterator t_it);
+        void Evict();
+    };
+}
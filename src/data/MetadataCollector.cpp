@@ -0,0 +1,360 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "MetadataCollector.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+
+#include <thread>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "Log.h"
+#include "IcProfile.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::MetadataCollector::MetadataCollector(const bool t_useIoUring)
+    : m_euid{ geteuid() }
+    , m_egid{ getegid() }
+{
+    if (const auto count{ getgroups(0, nullptr) }; count > 0)
+    {
+        m_groups.resize(static_cast<std::size_t>(count));
+        m_groups.resize(static_cast<std::size_t>(std::max(0, getgroups(count, m_groups.data()))));
+    }
+
+    if (t_useIoUring && !SetupRing())
+    {
+        CleanUp();
+    }
+}
+
+ic::data::MetadataCollector::~MetadataCollector() noexcept
+{
+    CleanUp();
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::MetadataCollector::Collect(const std::stop_token& t_stopToken, const int t_dirFd, std::vector<Entry>& t_entries)
+{
+    if (UsesIoUring())
+    {
+        CollectWithIoUring(t_stopToken, t_dirFd, t_entries);
+    }
+    else
+    {
+        CollectWithThreads(t_stopToken, t_dirFd, t_entries);
+    }
+}
+
+//-------------------------------------------------
+// Init
+//-------------------------------------------------
+
+bool ic::data::MetadataCollector::SetupRing()
+{
+    io_uring_params params{};
+    m_ringFd = static_cast<int>(syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params));
+    if (m_ringFd < 0)
+    {
+        IC_LOG_DEBUG("[MetadataCollector::SetupRing()] io_uring is not available: {}", std::strerror(errno));
+        return false;
+    }
+
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !ProbeStatx())
+    {
+        IC_LOG_DEBUG("[MetadataCollector::SetupRing()] The kernel is too old for io_uring statx.");
+        return false;
+    }
+
+    m_sqEntries = params.sq_entries;
+
+    // with IORING_FEAT_SINGLE_MMAP both rings share one mapping
+    m_sqRingSize = std::max(
+        params.sq_off.array + params.sq_entries * sizeof(unsigned),
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe)
+    );
+    m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+    if (m_sqRing == MAP_FAILED)
+    {
+        m_sqRing = nullptr;
+        return false;
+    }
+    m_cqRing = m_sqRing;
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    auto* sqes{ mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES) };
+    if (sqes == MAP_FAILED)
+    {
+        return false;
+    }
+    m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq{ static_cast<char*>(m_sqRing) };
+    m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    m_sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    auto* cq{ static_cast<char*>(m_cqRing) };
+    m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    return true;
+}
+
+bool ic::data::MetadataCollector::ProbeStatx() const
+{
+    // IORING_REGISTER_PROBE came with the same kernel as IORING_OP_STATX
+    std::vector<char> buffer(sizeof(io_uring_probe) + (IORING_OP_STATX + 1) * sizeof(io_uring_probe_op));
+    auto* probe{ reinterpret_cast<io_uring_probe*>(buffer.data()) };
+    if (syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_PROBE, probe, IORING_OP_STATX + 1) < 0)
+    {
+        return false;
+    }
+
+    return probe->last_op >= IORING_OP_STATX && (probe->ops[IORING_OP_STATX].flags & IO_URING_OP_SUPPORTED);
+}
+
+//-------------------------------------------------
+// Collect
+//-------------------------------------------------
+
+void ic::data::MetadataCollector::CollectWithIoUring(const std::stop_token& t_stopToken, const int t_dirFd, std::vector<Entry>& t_entries)
+{
+    m_results.resize(t_entries.size());
+
+    // the entries still to be submitted; symlinks found on the way are submitted again
+    std::vector<std::uint32_t> pending(t_entries.size());
+    for (std::uint32_t i{ 0 }; i < pending.size(); ++i)
+    {
+        pending[i] = static_cast<std::uint32_t>(pending.size() - 1 - i);
+    }
+
+    // requests queued but not yet consumed by the kernel must not be left behind for the next call
+    const auto unsubmitted{ [this] { return *m_sqTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE); } };
+
+    unsigned inFlight{ 0 };
+    while (!pending.empty() || inFlight > 0 || unsubmitted() > 0)
+    {
+        // the buffers must stay valid until all requests in flight are completed
+        if (t_stopToken.stop_requested())
+        {
+            pending.clear();
+        }
+
+        // fill the submission queue; requests not yet consumed by the kernel are submitted again
+        auto tail{ *m_sqTail };
+        auto queued{ unsubmitted() };
+        while (!pending.empty() && inFlight + queued < m_sqEntries)
+        {
+            const auto index{ pending.back() };
+            pending.pop_back();
+
+            const auto& entry{ t_entries[index] };
+            const auto slot{ tail & *m_sqMask };
+
+            auto& sqe{ m_sqes[slot] };
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_STATX;
+            sqe.fd = t_dirFd;
+            sqe.addr = reinterpret_cast<std::uint64_t>(entry.name.c_str());
+            sqe.len = STATX_BASIC_STATS;
+            sqe.off = reinterpret_cast<std::uint64_t>(&m_results[index]);
+            // symlinks are followed; an unknown type is checked for a symlink first
+            sqe.statx_flags = entry.typeUnknown && !entry.symlink ? AT_SYMLINK_NOFOLLOW : 0;
+            sqe.user_data = index;
+
+            m_sqArray[slot] = slot;
+            ++tail;
+            ++queued;
+        }
+        __atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+
+        // submit and wait for at least one completion
+        const auto submitted{ IC_PROFILE_FS(IO_URING, "MetadataCollector::CollectWithIoUring", syscall(__NR_io_uring_enter, m_ringFd, queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0)) };
+        if (submitted < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            IC_LOG_ERROR("[MetadataCollector::CollectWithIoUring()] io_uring_enter failed: {}", std::strerror(errno));
+
+            // the kernel may still write the results of the requests in flight
+            Drain(inFlight);
+            CleanUp();
+            CollectWithThreads(t_stopToken, t_dirFd, t_entries);
+
+            return;
+        }
+        if (submitted > 0)
+        {
+            inFlight += static_cast<unsigned>(submitted);
+        }
+
+        // reap the completions
+        auto head{ *m_cqHead };
+        const auto cqTail{ __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE) };
+        for (; head != cqTail; ++head)
+        {
+            const auto& cqe{ m_cqes[head & *m_cqMask] };
+            const auto index{ static_cast<std::uint32_t>(cqe.user_data) };
+            auto& entry{ t_entries[index] };
+            const auto& result{ m_results[index] };
+            --inFlight;
+
+            if (cqe.res == -EINVAL)
+            {
+                // the opcode is rejected after all
+                entry.ReadMetadata(t_dirFd);
+                continue;
+            }
+
+            if (cqe.res < 0)
+            {
+                // a dangling symlink or the entry has been removed
+                entry.missing = cqe.res == -ENOENT && entry.typeUnknown && !entry.symlink;
+                entry.type = EntryType::OTHER;
+                entry.typeUnknown = false;
+                entry.accessible = false;
+                continue;
+            }
+
+            if (entry.typeUnknown && !entry.symlink && S_ISLNK(result.stx_mode))
+            {
+                entry.symlink = true;
+                pending.push_back(index);
+                continue;
+            }
+
+            entry.SetMetadata(result);
+            entry.accessible = IsReadable(result) || IC_PROFILE_FS(ACCESS, "MetadataCollector::CollectWithIoUring", faccessat(t_dirFd, entry.name.c_str(), R_OK, 0)) == 0;
+        }
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    }
+}
+
+void ic::data::MetadataCollector::CollectWithThreads(const std::stop_token& t_stopToken, const int t_dirFd, std::vector<Entry>& t_entries)
+{
+    const auto threads{ std::min({ MAX_THREADS, t_entries.size() / MIN_ENTRIES_PER_THREAD, static_cast<std::size_t>(std::thread::hardware_concurrency()) }) };
+
+    const auto collect{ [&](const std::size_t t_first, const std::size_t t_last) {
+        for (auto i{ t_first }; i < t_last && !t_stopToken.stop_requested(); ++i)
+        {
+            t_entries[i].ReadMetadata(t_dirFd);
+        }
+    } };
+
+    if (threads < 2)
+    {
+        collect(0, t_entries.size());
+        return;
+    }
+
+    const auto chunk{ (t_entries.size() + threads - 1) / threads };
+    std::vector<std::jthread> workers;
+    workers.reserve(threads);
+    for (std::size_t first{ 0 }; first < t_entries.size(); first += chunk)
+    {
+        workers.emplace_back(collect, first, std::min(first + chunk, t_entries.size()));
+    }
+}
+
+void ic::data::MetadataCollector::Drain(unsigned t_inFlight)
+{
+    // the unsubmitted requests are withdrawn
+    __atomic_store_n(m_sqTail, __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+
+    while (t_inFlight > 0)
+    {
+        auto head{ *m_cqHead };
+        const auto cqTail{ __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE) };
+        t_inFlight -= std::min(t_inFlight, cqTail - head);
+        head = cqTail;
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+        if (t_inFlight > 0 &&
+            syscall(__NR_io_uring_enter, m_ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+            errno != EINTR)
+        {
+            IC_LOG_ERROR("[MetadataCollector::Drain()] Waiting for {} requests failed: {}", t_inFlight, std::strerror(errno));
+            return;
+        }
+    }
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+bool ic::data::MetadataCollector::IsReadable(const struct statx& t_statx) const
+{
+    if (m_euid == 0)
+    {
+        return true;
+    }
+
+    if (t_statx.stx_uid == m_euid)
+    {
+        return t_statx.stx_mode & S_IRUSR;
+    }
+
+    if (t_statx.stx_gid == m_egid || std::find(m_groups.begin(), m_groups.end(), t_statx.stx_gid) != m_groups.end())
+    {
+        return t_statx.stx_mode & S_IRGRP;
+    }
+
+    return t_statx.stx_mode & S_IROTH;
+}
+
+//-------------------------------------------------
+// Clean up
+//-------------------------------------------------
+
+void ic::data::MetadataCollector::CleanUp()
+{
+    if (m_sqes)
+    {
+        munmap(m_sqes, m_sqesSize);
+        m_sqes = nullptr;
+    }
+
+    if (m_sqRing)
+    {
+        munmap(m_sqRing, m_sqRingSize);
+        m_sqRing = nullptr;
+        m_cqRing = nullptr;
+    }
+
+    if (m_ringFd >= 0)
+    {
+        close(m_ringFd);
+        m_ringFd = -1;
+    }
+}
+
+#endif
@@ -0,0 +1,172 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+
+#include <vector>
+#include <stop_token>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <linux/io_uring.h>
+#include "Entry.h"
+
+namespace ic::data
+{
+    /**
+     * Reads the metadata of many entries of a directory at once.
+     * If available, batches of IORING_OP_STATX requests are submitted to an io_uring;
+     * otherwise the entries are split between some threads calling fstatat.
+     */
+    class MetadataCollector
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The number of submission queue entries.
+         */
+        static constexpr unsigned QUEUE_DEPTH{ 256 };
+
+        /**
+         * Without io_uring, a thread gets at least this number of entries.
+         */
+        static constexpr std::size_t MIN_ENTRIES_PER_THREAD{ 256 };
+
+        /**
+         * Without io_uring, the maximum number of threads.
+         */
+        static constexpr std::size_t MAX_THREADS{ 8 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        MetadataCollector() = delete;
+
+        explicit MetadataCollector(bool t_useIoUring);
+
+        MetadataCollector(const MetadataCollector& t_other) = delete;
+        MetadataCollector(MetadataCollector&& t_other) noexcept = delete;
+        MetadataCollector& operator=(const MetadataCollector& t_other) = delete;
+        MetadataCollector& operator=(MetadataCollector&& t_other) noexcept = delete;
+
+        ~MetadataCollector() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool UsesIoUring() const { return m_ringFd >= 0; }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Reads the metadata of the entries.
+         *
+         * @param t_stopToken Stops collecting; the entries are left incomplete.
+         * @param t_dirFd A file descriptor of the directory that contains the entries.
+         * @param t_entries The entries.
+         */
+        void Collect(const std::stop_token& t_stopToken, int t_dirFd, std::vector<Entry>& t_entries);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        int m_ringFd{ -1 };
+        unsigned m_sqEntries{ 0 };
+
+        void* m_sqRing{ nullptr };
+        std::size_t m_sqRingSize{ 0 };
+        unsigned* m_sqHead{ nullptr };
+        unsigned* m_sqTail{ nullptr };
+        unsigned* m_sqMask{ nullptr };
+        unsigned* m_sqArray{ nullptr };
+
+        io_uring_sqe* m_sqes{ nullptr };
+        std::size_t m_sqesSize{ 0 };
+
+        void* m_cqRing{ nullptr };
+        unsigned* m_cqHead{ nullptr };
+        unsigned* m_cqTail{ nullptr };
+        unsigned* m_cqMask{ nullptr };
+        io_uring_cqe* m_cqes{ nullptr };
+
+        /**
+         * The kernel writes the results of the statx requests here.
+         */
+        std::vector<struct statx> m_results;
+
+        uid_t m_euid;
+        gid_t m_egid;
+        std::vector<gid_t> m_groups;
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        bool SetupRing();
+
+        /**
+         * Asks the kernel whether IORING_OP_STATX is supported (Linux 5.6).
+         */
+        [[nodiscard]] bool ProbeStatx() const;
+
+        //-------------------------------------------------
+        // Collect
+        //-------------------------------------------------
+
+        void CollectWithIoUring(const std::stop_token& t_stopToken, int t_dirFd, std::vector<Entry>& t_entries);
+        static void CollectWithThreads(const std::stop_token& t_stopToken, int t_dirFd, std::vector<Entry>& t_entries);
+
+        /**
+         * Waits for the completions of the requests in flight and drops them,
+         * so the kernel no longer writes to the buffers.
+         *
+         * @param t_inFlight The number of requests in flight.
+         */
+        void Drain(unsigned t_inFlight);
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Checks the read permission using the mode bits, without a syscall.
+         * ACLs are not considered, so a denied permission has to be confirmed.
+         */
+        [[nodiscard]] bool IsReadable(const struct statx& t_statx) const;
+
+        //-------------------------------------------------
+        // Clean up
+        //-------------------------------------------------
+
+        void CleanUp();
+    };
+}
+
+#endif
@@ -0,0 +1,205 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "Prefetcher.h"
+#include "Scanner.h"
+#include "Entries.h"
+#include "ListingCache.h"
+#include "application/Application.h"
+#include "application/Util.h"
+#include "Log.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::Prefetcher::Prefetcher()
+{
+    IC_LOG_DEBUG("[Prefetcher::Prefetcher()] Create Prefetcher.");
+
+    const auto& ini{ application::Application::INI };
+    m_enabled = ini.Get<bool>("prefetch", "enabled", true);
+    m_useIoUring = ini.Get<bool>("scan", "io_uring", true);
+    m_depth = std::max(ini.Get<int>("prefetch", "depth", 1), 1);
+    m_maxJobs = std::max(ini.Get<int>("prefetch", "max_jobs", 2), 1);
+    m_maxEntries = std::max(ini.Get<int>("prefetch", "max_entries", 100'000), 1);
+
+    AppendListeners();
+}
+
+ic::data::Prefetcher::~Prefetcher() noexcept
+{
+    IC_LOG_DEBUG("[Prefetcher::~Prefetcher()] Destruct Prefetcher.");
+
+    // the jthread destructors request a stop and join
+    Cancel();
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::Prefetcher::Request(const std::filesystem::path& t_path)
+{
+    if (!m_enabled || t_path == m_requestedPath)
+    {
+        return;
+    }
+
+    // the user keeps moving: the previous requests are no longer of interest
+    for (auto& job : m_jobs)
+    {
+        if (job.path != t_path)
+        {
+            job.thread.request_stop();
+        }
+    }
+
+    m_requestedPath = t_path;
+    m_requestTime = std::chrono::steady_clock::now();
+}
+
+void ic::data::Prefetcher::Cancel()
+{
+    for (auto& job : m_jobs)
+    {
+        job.thread.request_stop();
+    }
+
+    m_requestedPath.clear();
+}
+
+void ic::data::Prefetcher::Update()
+{
+    std::erase_if(m_jobs, [](const Job& t_job) {
+        return t_job.finished->load();
+    });
+
+    if (m_requestedPath.empty() ||
+        std::chrono::steady_clock::now() - m_requestTime < DELAY ||
+        m_jobs.size() >= m_maxJobs)
+    {
+        return;
+    }
+
+    const auto running{ std::ranges::any_of(m_jobs, [this](const Job& t_job) {
+        return t_job.path == m_requestedPath && !t_job.thread.get_stop_token().stop_requested();
+    }) };
+
+    if (!running && !application::Application::listing_cache.Contains(m_requestedPath))
+    {
+        IC_LOG_DEBUG("[Prefetcher::Update()] Prefetch {}.", m_requestedPath.string());
+
+        auto finished{ std::make_shared<std::atomic_bool>(false) };
+        std::jthread thread{ &Prefetcher::Run, finished, m_requestedPath, m_depth, m_maxEntries, m_useIoUring };
+        m_jobs.push_back({ m_requestedPath, std::move(finished), std::move(thread) });
+    }
+
+    // the path is not requested again until the user moves on
+    m_requestTime = std::chrono::steady_clock::time_point::max();
+}
+
+//-------------------------------------------------
+// Listeners
+//-------------------------------------------------
+
+void ic::data::Prefetcher::AppendListeners()
+{
+    auto& bus{ application::Application::event_bus };
+
+    bus.AppendListener(event::IcEventType::SHOW_PATH_INFO, [this](const event::IcEvent& t_event) {
+        // the view knows the type of the entry
+        if (t_event.directory)
+        {
+            Request(t_event.path);
+        }
+    });
+
+    bus.AppendListener(event::IcEventType::HOVER_PATH, [this](const event::IcEvent& t_event) {
+        Request(t_event.path);
+    });
+
+    // the directory is entered anyway: a running job only competes with the scanner
+    bus.AppendListener(event::IcEventType::IN_DIR, [this]([[maybe_unused]] const event::IcEvent& t_event) {
+        Cancel();
+    });
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::Prefetcher::Run(
+    const std::stop_token& t_stopToken,
+    const std::shared_ptr<std::atomic_bool>& t_finished,
+    const std::filesystem::path& t_path,
+    const std::size_t t_depth,
+    const std::size_t t_maxEntries,
+    const bool t_useIoUring
+)
+{
+    application::Util::LowerThreadPriority();
+
+    auto& cache{ application::Application::listing_cache };
+
+    // depth first, the requested directory is read first
+    std::vector<std::pair<std::filesystem::path, std::size_t>> pending{ { t_path, t_depth } };
+    for (std::size_t count{ 0 }; !pending.empty() && count < MAX_DIRECTORIES && !t_stopToken.stop_requested(); ++count)
+    {
+        const auto [path, depth]{ std::move(pending.back()) };
+        pending.pop_back();
+
+        if (cache.Contains(path))
+        {
+            continue;
+        }
+
+        // the stamp is read first, so that changes while reading invalidate the listing
+        const auto stamp{ DirectoryStamp::Read(path) };
+        Scanner::Batch batch;
+        if (!stamp || !Scanner::ReadAll(t_stopToken, path, t_useIoUring, t_maxEntries, batch))
+        {
+            continue;
+        }
+
+        if (depth > 1)
+        {
+            for (const auto& entry : batch)
+            {
+                if (entry.IsDirectory() && entry.accessible && !entry.symlink)
+                {
+                    pending.emplace_back(entry.path, depth - 1);
+                }
+            }
+        }
+
+        Entries entries;
+        std::vector<Scanner::Batch> batches;
+        batches.push_back(std::move(batch));
+        entries.Insert(std::move(batches));
+
+        if (!cache.TryPut(path, { *stamp, std::move(entries.filesAndDirs), std::move(entries.rows), entries.sortSpec }))
+        {
+            IC_LOG_DEBUG("[Prefetcher::Run()] The listing cache is full, stop prefetching.");
+            break;
+        }
+    }
+
+    *t_finished = true;
+}
@@ -0,0 +1,147 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace ic::data
+{
+    /**
+     * Reads the selected or hovered directory in the background
+     * and stores the listing in the listing cache, so that entering
+     * the directory needs no scan.
+     */
+    class Prefetcher
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * A directory is only read if it was requested for this time.
+         */
+        static constexpr std::chrono::milliseconds DELAY{ 150 };
+
+        /**
+         * The maximum number of directories read for one request.
+         */
+        static constexpr std::size_t MAX_DIRECTORIES{ 64 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Prefetcher();
+
+        Prefetcher(const Prefetcher& t_other) = delete;
+        Prefetcher(Prefetcher&& t_other) noexcept = delete;
+        Prefetcher& operator=(const Prefetcher& t_other) = delete;
+        Prefetcher& operator=(Prefetcher&& t_other) noexcept = delete;
+
+        ~Prefetcher() noexcept;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Requests a directory. Jobs for other directories are cancelled.
+         *
+         * @param t_path The directory.
+         */
+        void Request(const std::filesystem::path& t_path);
+
+        /**
+         * Cancels all jobs and the pending request.
+         */
+        void Cancel();
+
+        /**
+         * Starts a job for the pending request and joins finished jobs.
+         * Must be called from the UI thread.
+         */
+        void Update();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Job
+        {
+            std::filesystem::path path;
+            std::shared_ptr<std::atomic_bool> finished;
+            std::jthread thread;
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        bool m_enabled{ true };
+        bool m_useIoUring{ false };
+
+        /**
+         * 1 reads only the requested directory, 2 also its subdirectories and so on.
+         */
+        std::size_t m_depth{ 1 };
+
+        /**
+         * The maximum number of jobs at the same time.
+         */
+        std::size_t m_maxJobs{ 2 };
+
+        /**
+         * Larger directories are not prefetched.
+         */
+        std::size_t m_maxEntries{ 100'000 };
+
+        std::filesystem::path m_requestedPath;
+        std::chrono::steady_clock::time_point m_requestTime;
+
+        std::vector<Job> m_jobs;
+
+        //-------------------------------------------------
+        // Listeners
+        //-------------------------------------------------
+
+        void AppendListeners();
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        static void Run(
+            const std::stop_token& t_stopToken,
+            const std::shared_ptr<std::atomic_bool>& t_finished,
+            const std::filesystem::path& t_path,
+            std::size_t t_depth,
+            std::size_t t_maxEntries,
+            bool t_useIoUring
+        );
+    };
+}
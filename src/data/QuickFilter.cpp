@@ -0,0 +1,241 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <bit>
+#include <cstring>
+#include "QuickFilter.h"
+#include "Collation.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::QuickFilter::Update(const Entries& t_entries, const std::string_view t_query)
+{
+    auto query{ Collation::FoldCase(t_query) };
+
+    if (query.empty())
+    {
+        // the names are kept for the next query
+        if (IsActive())
+        {
+            m_query.clear();
+            m_matches.clear();
+            m_rows.clear();
+            std::fill(m_matching.begin(), m_matching.end(), 0);
+        }
+
+        return;
+    }
+
+    auto changed{ false };
+    auto narrowed{ false };
+
+    if (t_entries.generation != m_generation || m_offsets.size() - 1 > t_entries.filesAndDirs.size())
+    {
+        Clear();
+        m_generation = t_entries.generation;
+    }
+
+    // new entries are matched with the previous query; a changed query is applied below
+    if (const auto count{ static_cast<std::uint32_t>(m_offsets.size() - 1) }; count < t_entries.filesAndDirs.size())
+    {
+        Append(t_entries);
+        if (!m_query.empty())
+        {
+            Match(count, static_cast<std::uint32_t>(m_offsets.size() - 1));
+        }
+        changed = true;
+    }
+
+    if (query != m_query)
+    {
+        // a longer query only matches a subset of the previous matches
+        narrowed = !m_query.empty() && query.find(m_query) != std::string::npos;
+        m_query = std::move(query);
+
+        if (narrowed)
+        {
+            MatchPrevious();
+        }
+        else
+        {
+            m_matches.clear();
+            std::fill(m_matching.begin(), m_matching.end(), 0);
+            Match(0, static_cast<std::uint32_t>(m_offsets.size() - 1));
+        }
+        changed = true;
+    }
+
+    if (t_entries.revision != m_revision || (changed && !narrowed))
+    {
+        UpdateRows(t_entries);
+        m_revision = t_entries.revision;
+    }
+    else if (narrowed)
+    {
+        // the rows are a subset of the previous rows in the same order
+        std::erase_if(m_rows, [&](const std::uint32_t t_row) {
+            return !m_matching[t_entries.rows[t_row].index];
+        });
+    }
+}
+
+std::size_t ic::data::QuickFilter::Find(const char* t_haystack, const std::size_t t_size, const std::string_view t_needle)
+{
+    const auto length{ t_needle.size() };
+    if (length > t_size)
+    {
+        return std::string_view::npos;
+    }
+
+#if defined(__SSE2__) || defined(_M_X64)
+    // compare the first and the last character of the needle at 16 positions at once
+    const auto first{ _mm_set1_epi8(t_needle.front()) };
+    const auto last{ _mm_set1_epi8(t_needle.back()) };
+    const auto positions{ t_size - length + 1 };
+
+    for (std::size_t i{ 0 }; i < positions; i += 16)
+    {
+        const auto blockFirst{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_haystack + i)) };
+        const auto blockLast{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_haystack + i + length - 1)) };
+
+        auto mask{ static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)))) };
+
+        // positions past the end of the haystack
+        if (positions - i < 16)
+        {
+            mask &= (1u << (positions - i)) - 1;
+        }
+
+        while (mask != 0)
+        {
+            const auto pos{ i + static_cast<std::size_t>(std::countr_zero(mask)) };
+            if (length <= 2 || std::memcmp(t_haystack + pos + 1, t_needle.data() + 1, length - 2) == 0)
+            {
+                return pos;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    return std::string_view::npos;
+#else
+    return std::string_view(t_haystack, t_size).find(t_needle);
+#endif
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::QuickFilter::Append(const Entries& t_entries)
+{
+    // the padding is overwritten
+    m_names.resize(m_offsets.back());
+
+    auto size{ m_names.size() + PADDING };
+    for (auto i{ m_offsets.size() - 1 }; i < t_entries.filesAndDirs.size(); ++i)
+    {
+        size += t_entries.filesAndDirs[i].sortKey.size() + 1;
+    }
+    m_names.reserve(size);
+    m_offsets.reserve(t_entries.filesAndDirs.size() + 1);
+
+    for (auto i{ m_offsets.size() - 1 }; i < t_entries.filesAndDirs.size(); ++i)
+    {
+        const auto& key{ t_entries.filesAndDirs[i].sortKey };
+        m_names.insert(m_names.end(), key.begin(), key.end());
+        m_names.push_back(0);
+        m_offsets.push_back(static_cast<std::uint32_t>(m_names.size()));
+    }
+
+    m_names.resize(m_names.size() + PADDING, 0);
+    m_matching.resize(m_offsets.size() - 1, 0);
+}
+
+void ic::data::QuickFilter::Match(const std::uint32_t t_first, const std::uint32_t t_last)
+{
+    // the names are searched as one string; after a match the search continues with the next name
+    const auto end{ m_offsets[t_last] };
+    auto pos{ m_offsets[t_first] };
+    auto index{ t_first };
+
+    while (pos < end)
+    {
+        const auto found{ Find(m_names.data() + pos, end - pos, m_query) };
+        if (found == std::string_view::npos)
+        {
+            break;
+        }
+
+        // the name that contains the match
+        pos += static_cast<std::uint32_t>(found);
+        while (m_offsets[index + 1] <= pos)
+        {
+            ++index;
+        }
+
+        m_matches.push_back(index);
+        m_matching[index] = 1;
+
+        pos = m_offsets[++index];
+    }
+}
+
+void ic::data::QuickFilter::MatchPrevious()
+{
+    std::erase_if(m_matches, [this](const std::uint32_t t_index) {
+        if (Find(m_names.data() + m_offsets[t_index], m_offsets[t_index + 1] - m_offsets[t_index] - 1, m_query) != std::string_view::npos)
+        {
+            return false;
+        }
+
+        m_matching[t_index] = 0;
+        return true;
+    });
+}
+
+void ic::data::QuickFilter::UpdateRows(const Entries& t_entries)
+{
+    m_rows.clear();
+    m_rows.reserve(m_matches.size());
+
+    for (std::uint32_t row{ 0 }; row < t_entries.rows.size(); ++row)
+    {
+        if (m_matching[t_entries.rows[row].index])
+        {
+            m_rows.push_back(row);
+        }
+    }
+}
+
+void ic::data::QuickFilter::Clear()
+{
+    m_query.clear();
+    m_names.clear();
+    m_offsets.assign(1, 0);
+    m_matches.clear();
+    m_matching.clear();
+    m_rows.clear();
+}
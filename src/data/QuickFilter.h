@@ -0,0 +1,144 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "Entries.h"
+
+namespace ic::data
+{
+    /**
+     * Narrows the rows of a listing to the entries whose name contains a query.
+     * The case-folded names are copied into one contiguous buffer, which is
+     * searched at once with SSE2 where available. A query that contains the previous
+     * query only searches the previous matches. The buffer is kept while
+     * the entries do not change.
+     */
+    class QuickFilter
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        QuickFilter() = default;
+
+        QuickFilter(const QuickFilter& t_other) = delete;
+        QuickFilter(QuickFilter&& t_other) noexcept = delete;
+        QuickFilter& operator=(const QuickFilter& t_other) = delete;
+        QuickFilter& operator=(QuickFilter&& t_other) noexcept = delete;
+
+        ~QuickFilter() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsActive() const { return !m_query.empty(); }
+
+        /**
+         * @return The positions in Entries::rows of the matching rows, in display order.
+         */
+        [[nodiscard]] const std::vector<std::uint32_t>& GetRows() const { return m_rows; }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Applies the query to the entries. Only changes are processed.
+         *
+         * @param t_entries The entries.
+         * @param t_query The query as typed by the user.
+         */
+        void Update(const Entries& t_entries, std::string_view t_query);
+
+        /**
+         * Searches a non-empty needle.
+         * Reads up to 15 bytes past the end of t_haystack, which must be readable.
+         *
+         * @param t_haystack The string to search.
+         * @param t_size The size of the string.
+         * @param t_needle The string to search for.
+         *
+         * @return The position of the first match or std::string_view::npos.
+         */
+        [[nodiscard]] static std::size_t Find(const char* t_haystack, std::size_t t_size, std::string_view t_needle);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Zero bytes after the last name, so that the last name can be read in blocks of 16 bytes.
+         */
+        static constexpr std::size_t PADDING{ 16 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The case-folded query.
+         */
+        std::string m_query;
+
+        /**
+         * The case-folded names of all entries, each terminated by a zero byte,
+         * so that no match spans two names.
+         */
+        std::vector<char> m_names;
+
+        /**
+         * The start of each name in m_names; one more than there are entries.
+         */
+        std::vector<std::uint32_t> m_offsets{ 0 };
+
+        /**
+         * The indices of the matching entries.
+         */
+        std::vector<std::uint32_t> m_matches;
+
+        /**
+         * One flag per entry: 1 if it matches.
+         */
+        std::vector<std::uint8_t> m_matching;
+
+        std::vector<std::uint32_t> m_rows;
+
+        std::size_t m_generation{ 0 };
+        std::size_t m_revision{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void Append(const Entries& t_entries);
+        void Match(std::uint32_t t_first, std::uint32_t t_last);
+        void MatchPrevious();
+        void UpdateRows(const Entries& t_entries);
+        void Clear();
+    };
+}
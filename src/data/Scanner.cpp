@@ -0,0 +1,420 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <cstring>
+#include "Scanner.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <dirent.h>
+#endif
+
+#include "GetdentsReader.h"
+#include "MetadataCollector.h"
+#include "Log.h"
+#include "IcProfile.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::Scanner::Scanner(const bool t_useIoUring)
+    : m_useIoUring{ t_useIoUring }
+{
+    IC_LOG_DEBUG("[Scanner::Scanner()] Create Scanner.");
+}
+
+ic::data::Scanner::~Scanner() noexcept
+{
+    IC_LOG_DEBUG("[Scanner::~Scanner()] Destruct Scanner.");
+
+    // the jthread destructors request a stop and join
+    Cancel();
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool ic::data::Scanner::IsRunning() const
+{
+    return m_state && !m_state->finished;
+}
+
+std::optional<ic::data::DirectoryStamp> ic::data::Scanner::GetStamp() const
+{
+    if (!m_state)
+    {
+        return std::nullopt;
+    }
+
+    std::scoped_lock lock{ m_state->mutex };
+
+    return m_state->stamp;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::Scanner::Start(const std::filesystem::path& t_path)
+{
+    Retire();
+
+    m_state = std::make_shared<State>();
+    m_thread = std::jthread(&Scanner::Run, m_state, t_path, std::nullopt, m_useIoUring);
+
+    IC_LOG_DEBUG("[Scanner::Start()] Start scanning {}.", t_path.string());
+}
+
+void ic::data::Scanner::Validate(const std::filesystem::path& t_path, const DirectoryStamp& t_stamp)
+{
+    Retire();
+
+    m_state = std::make_shared<State>();
+    m_thread = std::jthread(&Scanner::Run, m_state, t_path, t_stamp, m_useIoUring);
+
+    IC_LOG_DEBUG("[Scanner::Validate()] Start validating {}.", t_path.string());
+}
+
+void ic::data::Scanner::Refresh(const std::filesystem::path& t_path, std::vector<std::string> t_names)
+{
+    Retire();
+
+    m_state = std::make_shared<State>();
+    m_thread = std::jthread(&Scanner::RunRefresh, m_state, t_path, std::move(t_names), m_useIoUring);
+
+    IC_LOG_DEBUG("[Scanner::Refresh()] Start refreshing {}.", t_path.string());
+}
+
+void ic::data::Scanner::Cancel()
+{
+    Retire();
+}
+
+bool ic::data::Scanner::Poll(std::vector<Batch>& t_batches, std::vector<std::string>& t_replaced, bool& t_reset)
+{
+    JoinFinished();
+
+    if (!m_state)
+    {
+        return false;
+    }
+
+    std::scoped_lock lock{ m_state->mutex };
+    if (m_state->batches.empty() && m_state->replaced.empty() && !m_state->reset)
+    {
+        return false;
+    }
+
+    t_reset = std::exchange(m_state->reset, false);
+
+    for (auto& batch : m_state->batches)
+    {
+        t_batches.push_back(std::move(batch));
+    }
+    m_state->batches.clear();
+
+    for (auto& name : m_state->replaced)
+    {
+        t_replaced.push_back(std::move(name));
+    }
+    m_state->replaced.clear();
+
+    return true;
+}
+
+bool ic::data::Scanner::ReadAll(
+    const std::stop_token& t_stopToken,
+    const std::filesystem::path& t_path,
+    [[maybe_unused]] const bool t_useIoUring,
+    const std::size_t t_maxEntries,
+    Batch& t_entries
+)
+{
+    const auto state{ std::make_shared<State>() };
+    Publisher publisher{ state, t_maxEntries };
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    const auto complete{ ReadWithGetdents(t_stopToken, publisher, t_path, t_useIoUring) };
+#else
+    const auto complete{ ReadWithIterator(t_stopToken, publisher, t_path) };
+#endif
+
+    if (!complete || t_stopToken.stop_requested())
+    {
+        return false;
+    }
+
+    publisher.Publish();
+
+    // no other thread has access to the state
+    for (auto& batch : state->batches)
+    {
+        if (t_entries.empty())
+        {
+            t_entries = std::move(batch);
+        }
+        else
+        {
+            std::move(batch.begin(), batch.end(), std::back_inserter(t_entries));
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::Scanner::Retire()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.request_stop();
+        m_retired.emplace_back(std::move(m_state), std::move(m_thread));
+    }
+
+    m_state.reset();
+
+    JoinFinished();
+}
+
+void ic::data::Scanner::JoinFinished()
+{
+    std::erase_if(m_retired, [](const auto& t_retired) {
+        return t_retired.first->finished.load();
+    });
+}
+
+void ic::data::Scanner::Run(
+    const std::stop_token& t_stopToken,
+    const std::shared_ptr<State>& t_state,
+    const std::filesystem::path& t_path,
+    const std::optional<DirectoryStamp>& t_cachedStamp,
+    [[maybe_unused]] const bool t_useIoUring
+)
+{
+    const auto stamp{ ReadStamp(t_state, t_path) };
+    if (t_cachedStamp)
+    {
+        if (stamp && *stamp == *t_cachedStamp)
+        {
+            t_state->finished = true;
+            return;
+        }
+
+        IC_LOG_DEBUG("[Scanner::Run()] The cached listing of {} is outdated, rescan.", t_path.string());
+
+        std::scoped_lock lock{ t_state->mutex };
+        t_state->reset = true;
+    }
+
+    Publisher publisher{ t_state };
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    ReadWithGetdents(t_stopToken, publisher, t_path, t_useIoUring);
+#else
+    ReadWithIterator(t_stopToken, publisher, t_path);
+#endif
+
+    if (t_stopToken.stop_requested())
+    {
+        IC_LOG_DEBUG("[Scanner::Run()] Scanning {} was cancelled.", t_path.string());
+    }
+    else
+    {
+        publisher.Publish();
+    }
+
+    t_state->finished = true;
+}
+
+void ic::data::Scanner::RunRefresh(
+    const std::stop_token& t_stopToken,
+    const std::shared_ptr<State>& t_state,
+    const std::filesystem::path& t_path,
+    const std::vector<std::string>& t_names,
+    [[maybe_unused]] const bool t_useIoUring
+)
+{
+    ReadStamp(t_state, t_path);
+
+    Batch batch;
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    if (const auto dirFd{ open(t_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) }; dirFd >= 0)
+    {
+        for (const auto& name : t_names)
+        {
+            batch.emplace_back(t_path, name, DT_UNKNOWN);
+        }
+
+        MetadataCollector collector{ t_useIoUring };
+        collector.Collect(t_stopToken, dirFd, batch);
+
+        close(dirFd);
+
+        std::erase_if(batch, [](const Entry& t_entry) { return t_entry.missing; });
+    }
+    else
+    {
+        batch.clear();
+    }
+#else
+    for (const auto& name : t_names)
+    {
+        if (std::error_code ec; std::filesystem::exists(IC_PROFILE_FS(LSTAT, "Scanner::RunRefresh", std::filesystem::symlink_status(t_path / name, ec))))
+        {
+            batch.emplace_back(std::filesystem::directory_entry(t_path / name, ec));
+        }
+    }
+#endif
+
+    if (!t_stopToken.stop_requested())
+    {
+        // replace the entries in one go
+        std::scoped_lock lock{ t_state->mutex };
+        t_state->replaced = t_names;
+        t_state->batches.push_back(std::move(batch));
+    }
+
+    t_state->finished = true;
+}
+
+std::optional<ic::data::DirectoryStamp> ic::data::Scanner::ReadStamp(const std::shared_ptr<State>& t_state, const std::filesystem::path& t_path)
+{
+    const auto stamp{ DirectoryStamp::Read(t_path) };
+
+    std::scoped_lock lock{ t_state->mutex };
+    t_state->stamp = stamp;
+
+    return stamp;
+}
+
+bool ic::data::Scanner::ReadWithIterator(const std::stop_token& t_stopToken, Publisher& t_publisher, const std::filesystem::path& t_path)
+{
+    std::error_code ec;
+    std::filesystem::directory_iterator it{ IC_PROFILE_FS(READDIR, "Scanner::ReadWithIterator", std::filesystem::directory_iterator(t_path, std::filesystem::directory_options::skip_permission_denied, ec)) };
+    if (ec)
+    {
+        IC_LOG_WARN("[Scanner::ReadWithIterator()] Unable to read directory {}: {}", t_path.string(), ec.message());
+    }
+
+    for (const std::filesystem::directory_iterator end; !ec && it != end; it.increment(ec))
+    {
+        if (t_stopToken.stop_requested() || !t_publisher.Add(Entry(*it)))
+        {
+            return false;
+        }
+    }
+
+    return !ec;
+}
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+bool ic::data::Scanner::ReadWithGetdents(const std::stop_token& t_stopToken, Publisher& t_publisher, const std::filesystem::path& t_path, const bool t_useIoUring)
+{
+    GetdentsReader reader{ t_path };
+    if (!reader.IsOpen())
+    {
+        IC_LOG_WARN("[Scanner::ReadWithGetdents()] Unable to open directory {}: {}", t_path.string(), std::strerror(reader.GetError()));
+        return false;
+    }
+
+    MetadataCollector collector{ t_useIoUring };
+
+    // the metadata are collected for all entries of a filled buffer at once
+    Batch entries;
+    while (!t_stopToken.stop_requested() && reader.Read([&](const std::string_view t_name, const unsigned char t_dType) {
+        entries.emplace_back(t_path, t_name, t_dType);
+    }))
+    {
+        collector.Collect(t_stopToken, reader.GetFd(), entries);
+        if (t_stopToken.stop_requested())
+        {
+            return false;
+        }
+
+        for (auto& entry : entries)
+        {
+            if (!t_publisher.Add(std::move(entry)))
+            {
+                return false;
+            }
+        }
+
+        entries.clear();
+    }
+
+    if (reader.GetError() != 0)
+    {
+        IC_LOG_WARN("[Scanner::ReadWithGetdents()] Unable to read directory {}: {}", t_path.string(), std::strerror(reader.GetError()));
+        return false;
+    }
+
+    return !t_stopToken.stop_requested();
+}
+#endif
+
+//-------------------------------------------------
+// Publisher
+//-------------------------------------------------
+
+ic::data::Scanner::Publisher::Publisher(std::shared_ptr<State> t_state, const std::size_t t_maxEntries)
+    : m_state{ std::move(t_state) }
+    , m_batchSize{ FIRST_BATCH_SIZE }
+    , m_maxEntries{ t_maxEntries }
+    , m_lastPublish{ std::chrono::steady_clock::now() }
+{
+    m_batch.reserve(m_batchSize);
+}
+
+bool ic::data::Scanner::Publisher::Add(Entry&& t_entry)
+{
+    if (m_count == m_maxEntries)
+    {
+        return false;
+    }
+
+    m_batch.push_back(std::move(t_entry));
+    ++m_count;
+
+    if (m_batch.size() >= m_batchSize || std::chrono::steady_clock::now() - m_lastPublish >= BATCH_INTERVAL)
+    {
+        Publish();
+    }
+
+    return true;
+}
+
+void ic::data::Scanner::Publisher::Publish()
+{
+    if (!m_batch.empty())
+    {
+        std::scoped_lock lock{ m_state->mutex };
+        m_state->batches.push_back(std::move(m_batch));
+    }
+
+    m_batch = Batch();
+    m_batchSize = BATCH_SIZE;
+    m_batch.reserve(m_batchSize);
+    m_lastPublish = std::chrono::steady_clock::now();
+}
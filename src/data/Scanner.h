@@ -0,0 +1,263 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include "Entry.h"
+#include "ListingCache.h"
+
+namespace ic::data
+{
+    class Scanner
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        using Batch = std::vector<Entry>;
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The first batch is kept small so that the panel shows something at once.
+         */
+        static constexpr std::size_t FIRST_BATCH_SIZE{ 64 };
+
+        /**
+         * The maximum number of entries in a batch.
+         */
+        static constexpr std::size_t BATCH_SIZE{ 4096 };
+
+        /**
+         * A batch is published at the latest after this time, even if not full.
+         */
+        static constexpr std::chrono::milliseconds BATCH_INTERVAL{ 30 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Scanner() = delete;
+
+        /**
+         * @param t_useIoUring Use io_uring to read the metadata, if available (Linux only).
+         */
+        explicit Scanner(bool t_useIoUring);
+
+        Scanner(const Scanner& t_other) = delete;
+        Scanner(Scanner&& t_other) noexcept = delete;
+        Scanner& operator=(const Scanner& t_other) = delete;
+        Scanner& operator=(Scanner&& t_other) noexcept = delete;
+
+        ~Scanner() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsRunning() const;
+
+        /**
+         * @return The stamp of the directory, read by the worker before the entries.
+         */
+        [[nodiscard]] std::optional<DirectoryStamp> GetStamp() const;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Starts scanning the given directory in a worker thread.
+         * A scan that is still running is cancelled.
+         *
+         * @param t_path The directory to scan.
+         */
+        void Start(const std::filesystem::path& t_path);
+
+        /**
+         * Checks in a worker thread whether a cached listing of the given directory is still valid.
+         * If not, the directory is scanned and Poll() reports a reset with the first batches.
+         * A scan that is still running is cancelled.
+         *
+         * @param t_path The directory.
+         * @param t_stamp The stamp of the cached listing.
+         */
+        void Validate(const std::filesystem::path& t_path, const DirectoryStamp& t_stamp);
+
+        /**
+         * Reads some entries of the given directory again in a worker thread.
+         * A scan that is still running is cancelled.
+         *
+         * @param t_path The directory.
+         * @param t_names The names of the entries to read.
+         */
+        void Refresh(const std::filesystem::path& t_path, std::vector<std::string> t_names);
+
+        /**
+         * Cancels the running scan. Does not wait for the worker.
+         */
+        void Cancel();
+
+        /**
+         * Moves all batches published so far into t_batches.
+         * Must be called from the UI thread.
+         *
+         * @param t_batches Receives the batches.
+         * @param t_replaced Receives the names of the entries to be replaced by the batches.
+         *                   A refresh replaces all given names; missing entries are not in the batches.
+         * @param t_reset Is set if the cached listing is outdated and all entries are replaced by the batches.
+         *
+         * @return True if anything was received.
+         */
+        bool Poll(std::vector<Batch>& t_batches, std::vector<std::string>& t_replaced, bool& t_reset);
+
+        /**
+         * Reads all entries of the given directory in the calling thread.
+         *
+         * @param t_stopToken To cancel reading.
+         * @param t_path The directory to read.
+         * @param t_useIoUring Use io_uring to read the metadata, if available (Linux only).
+         * @param t_maxEntries Reading stops if the directory has more entries.
+         * @param t_entries Receives the entries in read order.
+         *
+         * @return True if the directory was read completely.
+         */
+        static bool ReadAll(
+            const std::stop_token& t_stopToken,
+            const std::filesystem::path& t_path,
+            bool t_useIoUring,
+            std::size_t t_maxEntries,
+            Batch& t_entries
+        );
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * The state shared between the UI thread and one worker.
+         */
+        struct State
+        {
+            std::mutex mutex;
+            std::vector<Batch> batches;
+            std::vector<std::string> replaced;
+            std::optional<DirectoryStamp> stamp;
+            bool reset{ false };
+            std::atomic_bool finished{ false };
+        };
+
+        /**
+         * Collects the entries read by a worker and publishes them in batches.
+         */
+        class Publisher
+        {
+        public:
+            explicit Publisher(std::shared_ptr<State> t_state, std::size_t t_maxEntries = SIZE_MAX);
+
+            /**
+             * @return False if the entry exceeds the maximum number of entries.
+             */
+            [[nodiscard]] bool Add(Entry&& t_entry);
+            void Publish();
+
+        private:
+            std::shared_ptr<State> m_state;
+            Batch m_batch;
+            std::size_t m_batchSize;
+            std::size_t m_count{ 0 };
+            std::size_t m_maxEntries;
+            std::chrono::steady_clock::time_point m_lastPublish;
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * Use io_uring to read the metadata.
+         */
+        bool m_useIoUring{ false };
+
+        /**
+         * The state of the current scan.
+         */
+        std::shared_ptr<State> m_state;
+
+        /**
+         * The worker of the current scan.
+         */
+        std::jthread m_thread;
+
+        /**
+         * Cancelled workers that have not finished yet.
+         * They are joined as soon as they are done, so the UI thread never waits.
+         */
+        std::vector<std::pair<std::shared_ptr<State>, std::jthread>> m_retired;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void Retire();
+        void JoinFinished();
+
+        static void Run(
+            const std::stop_token& t_stopToken,
+            const std::shared_ptr<State>& t_state,
+            const std::filesystem::path& t_path,
+            const std::optional<DirectoryStamp>& t_cachedStamp,
+            bool t_useIoUring
+        );
+        static void RunRefresh(const std::stop_token& t_stopToken, const std::shared_ptr<State>& t_state, const std::filesystem::path& t_path, const std::vector<std::string>& t_names, bool t_useIoUring);
+
+        /**
+         * Reads the stamp first, so that changes while reading invalidate it.
+         */
+        static std::optional<DirectoryStamp> ReadStamp(const std::shared_ptr<State>& t_state, const std::filesystem::path& t_path);
+
+        /**
+         * The portable backend: std::filesystem::directory_iterator.
+         * The backends return true if the directory was read completely.
+         */
+        static bool ReadWithIterator(const std::stop_token& t_stopToken, Publisher& t_publisher, const std::filesystem::path& t_path);
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+        /**
+         * The Linux backend: getdents64 and a MetadataCollector.
+         */
+        static bool ReadWithGetdents(const std::stop_token& t_stopToken, Publisher& t_publisher, const std::filesystem::path& t_path, bool t_useIoUring);
+#endif
+    };
+}
@@ -0,0 +1,98 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "Sorter.h"
+#include "Log.h"
+#include "vendor/magic/magic_enum.hpp"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::data::Sorter::Sorter()
+{
+    IC_LOG_DEBUG("[Sorter::Sorter()] Create Sorter.");
+}
+
+ic::data::Sorter::~Sorter() noexcept
+{
+    IC_LOG_DEBUG("[Sorter::~Sorter()] Destruct Sorter.");
+
+    // the jthread destructor requests a stop and joins
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::data::Sorter::Start(Entries& t_entries, const SortSpec& t_sortSpec)
+{
+    Cancel();
+
+    IC_LOG_DEBUG("[Sorter::Start()] Sort {} entries by {}.", t_entries.rows.size(), std::string(magic_enum::enum_name(t_sortSpec.key)));
+
+    // not worth a thread
+    if (t_entries.rows.size() < BACKGROUND_MIN_ROWS)
+    {
+        t_entries.SetRows(*t_entries.SortedRows({}, t_sortSpec), t_sortSpec);
+        return;
+    }
+
+    m_state = std::make_shared<State>();
+    m_state->sortSpec = t_sortSpec;
+    m_state->start = std::chrono::steady_clock::now();
+
+    m_thread = std::jthread([state = m_state, &t_entries](const std::stop_token& t_stopToken) {
+        state->rows = t_entries.SortedRows(t_stopToken, state->sortSpec);
+        state->finished = true;
+    });
+}
+
+void ic::data::Sorter::Cancel()
+{
+    if (m_thread.joinable())
+    {
+        // the sort stops between two parts of the rows; until then it reads the entries
+        m_thread.request_stop();
+        m_thread.join();
+    }
+
+    m_state.reset();
+}
+
+bool ic::data::Sorter::Update(Entries& t_entries)
+{
+    if (!m_state || !m_state->finished)
+    {
+        return false;
+    }
+
+    m_thread.join();
+
+    IC_LOG_DEBUG("[Sorter::Update()] Sorted {} entries in {} ms.",
+        t_entries.rows.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_state->start).count());
+
+    if (m_state->rows)
+    {
+        t_entries.SetRows(std::move(*m_state->rows), m_state->sortSpec);
+    }
+    m_state.reset();
+
+    return true;
+}
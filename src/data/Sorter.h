@@ -0,0 +1,122 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <optional>
+#include <chrono>
+#include <vector>
+#include "Entries.h"
+
+namespace ic::data
+{
+    /**
+     * Sorts the rows of the entries in another order in the background.
+     * The entries must not change until the sorted rows are taken by Update()
+     * or the sort is cancelled.
+     */
+    class Sorter
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Fewer rows are sorted at once in the calling thread.
+         */
+        static constexpr std::size_t BACKGROUND_MIN_ROWS{ Entries::PARALLEL_MIN_ROWS };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Sorter();
+
+        Sorter(const Sorter& t_other) = delete;
+        Sorter(Sorter&& t_other) noexcept = delete;
+        Sorter& operator=(const Sorter& t_other) = delete;
+        Sorter& operator=(Sorter&& t_other) noexcept = delete;
+
+        ~Sorter() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @return True until the sorted rows are taken or the sort is cancelled.
+         */
+        [[nodiscard]] bool IsRunning() const { return m_state != nullptr; }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Starts sorting the rows. A running sort is cancelled.
+         *
+         * @param t_entries The entries; they must outlive the sort.
+         * @param t_sortSpec The new order.
+         */
+        void Start(Entries& t_entries, const SortSpec& t_sortSpec);
+
+        /**
+         * Stops a running sort and waits for it, so that the entries can be changed.
+         */
+        void Cancel();
+
+        /**
+         * Replaces the rows when the sort is done. Must be called from the UI thread.
+         *
+         * @param t_entries The entries passed to Start().
+         *
+         * @return True if the rows were replaced.
+         */
+        bool Update(Entries& t_entries);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct State
+        {
+            SortSpec sortSpec;
+            std::optional<std::vector<Row>> rows;
+            std::chrono::steady_clock::time_point start;
+            std::atomic_bool finished{ false };
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The state of the running sort.
+         */
+        std::shared_ptr<State> m_state;
+
+        std::jthread m_thread;
+    };
+}
@@ -16,9 +16,9 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
-#include <eventpp/utilities/argumentadapter.h>
 #include "View.h"
 #include "IcAssert.h"
+#include "IcProfile.h"
 #include "application/Application.h"
 #include "widget/ViewWidget.h"
 #include "widget/InfoWidget.h"
@@ -37,13 +37,15 @@ ic::data::View::View(ViewType t_viewType)
 
     m_viewWidget = std::make_unique<widget::ViewWidget>(this);
     m_infoWidget = std::make_unique<widget::InfoWidget>(this);
+    m_scanner = std::make_unique<Scanner>(application::Application::INI.Get<bool>("scan", "io_uring", true));
+    m_watcher = std::make_unique<DirectoryWatcher>();
+    m_filter = std::make_unique<QuickFilter>();
+    m_sizer = std::make_unique<DirectorySizer>();
+    m_sorter = std::make_unique<Sorter>();
 
     AppendListeners();
 
-    application::Application::event_dispatcher.dispatch(
-        event::IcEventType::DIRTY,
-        event::DirtyEvent(viewType)
-    );
+    application::Application::event_bus.Publish(event::DirtyEvent(viewType));
 }
 
 ic::data::View::~View() noexcept
@@ -75,21 +77,105 @@ void ic::data::View::SetInfoSize(const float t_x, const float t_y) const
     m_infoWidget->SetSize(t_x, t_y);
 }
 
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool ic::data::View::IsScanning() const
+{
+    return m_scanner->IsRunning();
+}
+
+bool ic::data::View::IsBusy() const
+{
+    return dirty || m_scanner->IsRunning() || m_sizer->IsRunning() || m_sorter->IsRunning() || !m_refreshNames.empty();
+}
+
+bool ic::data::View::IsWatching() const
+{
+    return m_watcher->IsWatching();
+}
+
+const ic::data::QuickFilter& ic::data::View::GetFilter() const
+{
+    return *m_filter;
+}
+
+const ic::data::DirectorySizer& ic::data::View::GetDirectorySizer() const
+{
+    return *m_sizer;
+}
+
 //-------------------------------------------------
 // Logic
 //-------------------------------------------------
 
 void ic::data::View::Update()
 {
+    IC_PROFILE_SCOPE("View::Update");
+
     if (dirty)
     {
-        for (const auto& entry : std::filesystem::directory_iterator(currentPath))
+        // the entries are replaced
+        m_sorter->Cancel();
+
+        // watch first, so that no change after the validation of a cached listing is lost
+        m_watcher->Watch(currentPath);
+        if (!RestoreListing())
         {
-            entries.filesAndDirs.emplace(entry.path());
+            StartScan();
         }
 
         dirty = false;
     }
+
+    // before the filter, which stores positions in the rows
+    m_sorter->Update(entries);
+
+    // while the rows are sorted, the entries are read by the sorter and the changes wait
+    if (!m_sorter->IsRunning())
+    {
+        UpdateEntries();
+
+        if (m_sortSpec != entries.sortSpec)
+        {
+            m_sorter->Start(entries, m_sortSpec);
+        }
+    }
+
+    m_filter->Update(entries, filterQuery);
+    m_sizer->Update();
+}
+
+void ic::data::View::RequestSort(const SortSpec& t_sortSpec)
+{
+    m_sortSpec = t_sortSpec;
+}
+
+void ic::data::View::ComputeDirectorySizes()
+{
+    std::vector<std::filesystem::path> directories;
+    for (const auto& entry : entries.filesAndDirs)
+    {
+        // symlinks and junctions are not followed
+        if (entry.IsDirectory() && entry.accessible && !entry.symlink && !entry.junction &&
+            (selectedEntries.empty() || selectedEntries.contains(entry.path)))
+        {
+            directories.push_back(entry.path);
+        }
+    }
+
+    m_sizer->Start(std::move(directories));
+}
+
+void ic::data::View::CancelDirectorySizes()
+{
+    m_sizer->Cancel();
+}
+
+void ic::data::View::Refresh(std::vector<std::string> t_names)
+{
+    std::ranges::move(t_names, std::back_inserter(m_refreshNames));
 }
 
 void ic::data::View::Render() const
@@ -98,111 +184,212 @@ void ic::data::View::Render() const
     m_infoWidget->Render();
 }
 
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::data::View::UpdateEntries()
+{
+    // everything is published before the scanner has finished
+    const auto scanning{ m_scanner->IsRunning() };
+
+    std::vector<Scanner::Batch> batches;
+    std::vector<std::string> replaced;
+    auto reset{ false };
+    if (m_scanner->Poll(batches, replaced, reset))
+    {
+        // the cached listing is outdated and is replaced by a new scan
+        if (reset)
+        {
+            entries.Clear();
+        }
+
+        if (!replaced.empty())
+        {
+            RemoveEntries(replaced, batches);
+        }
+
+        entries.Insert(std::move(batches));
+    }
+
+    m_complete = !scanning;
+
+    // the changes are applied to the existing entries, but not while scanning
+    if (DirectoryWatcher::Changes changes; !scanning && m_watcher->Poll(changes))
+    {
+        if (changes.rescan)
+        {
+            IC_LOG_DEBUG("[View::UpdateEntries()] Too many changes in {}, rescan.", currentPath.string());
+            entries.Clear();
+            StartScan();
+        }
+        else
+        {
+            m_complete = false;
+            m_scanner->Refresh(currentPath, std::move(changes.names));
+        }
+    }
+
+    if (!m_refreshNames.empty() && !m_scanner->IsRunning())
+    {
+        m_complete = false;
+        m_scanner->Refresh(currentPath, std::exchange(m_refreshNames, {}));
+    }
+}
+
+void ic::data::View::RemoveEntries(const std::vector<std::string>& t_names, const std::vector<Scanner::Batch>& t_batches)
+{
+    entries.Remove(t_names);
+
+    // entries that no longer exist are deselected
+    std::unordered_set<std::string_view> existing;
+    for (const auto& batch : t_batches)
+    {
+        for (const auto& entry : batch)
+        {
+            existing.emplace(entry.name);
+        }
+    }
+
+    for (const auto& name : t_names)
+    {
+        if (!existing.contains(name))
+        {
+            const auto path{ currentPath / name };
+            selectedEntries.erase(path);
+            if (currentSelectedPath == path)
+            {
+                currentSelectedPath.clear();
+            }
+        }
+    }
+}
+
+void ic::data::View::StoreListing()
+{
+    // a listing still sorted in the background is stored in its previous order
+    m_sorter->Cancel();
+
+    if (!m_complete || dirty || m_scanner->IsRunning())
+    {
+        return;
+    }
+
+    const auto stamp{ m_scanner->GetStamp() };
+    if (!stamp)
+    {
+        return;
+    }
+
+    application::Application::listing_cache.Put(
+        currentPath,
+        { *stamp, std::move(entries.filesAndDirs), std::move(entries.rows), entries.sortSpec }
+    );
+
+    m_complete = false;
+}
+
+bool ic::data::View::RestoreListing()
+{
+    Listing listing;
+    if (!application::Application::listing_cache.Take(currentPath, listing))
+    {
+        return false;
+    }
+
+    IC_LOG_DEBUG("[View::RestoreListing()] Use {} cached entries of {}.", listing.filesAndDirs.size(), currentPath.string());
+
+    // the listing may have been sorted differently; Update() sorts it by the requested order
+    entries.Clear();
+    entries.filesAndDirs = std::move(listing.filesAndDirs);
+    entries.rows = std::move(listing.rows);
+    entries.sortSpec = listing.sortSpec;
+
+    // shown at once; the stamp is checked by the scanner, which rescans an outdated listing
+    m_scanner->Validate(currentPath, listing.stamp);
+    m_complete = false;
+
+    return true;
+}
+
+void ic::data::View::StartScan()
+{
+    // the scanner reads the stamp first, so that changes during the scan invalidate it
+    m_complete = false;
+
+    // a scan of the previous path is cancelled
+    m_scanner->Start(currentPath);
+}
+
 //-------------------------------------------------
 // Listeners
 //-------------------------------------------------
 
 void ic::data::View::AppendListeners()
 {
-    application::Application::event_dispatcher.appendListener(
-        event::IcEventType::UP_DIR,
-        eventpp::argumentAdapter<void(const event::UpDirEvent&)>(
-            [this](const event::UpDirEvent& t_event) {
-                if (!t_event.path.empty() && t_event.viewType == viewType)
-                {
-                    currentPath = t_event.path.parent_path();
-                    currentSelectedPath.clear();
-                    entries.filesAndDirs.clear();
-                    selectedEntries.clear();
-                    dirty = true;
-                    application::Application::current_view_type = viewType;
-                    IC_LOG_DEBUG("[View::AppendListeners()] Event type UP_DIR for view type {}.", std::string(magic_enum::enum_name(viewType)));
-                }
-            })
-    );
+    auto& bus{ application::Application::event_bus };
 
-    application::Application::event_dispatcher.appendListener(
-        event::IcEventType::IN_DIR,
-        eventpp::argumentAdapter<void(const event::InDirEvent&)>(
-            [this](const event::InDirEvent& t_event) {
-                if (!t_event.path.empty() && t_event.viewType == viewType)
-                {
-                    currentPath = t_event.path;
-                    currentSelectedPath.clear();
-                    entries.filesAndDirs.clear();
-                    selectedEntries.clear();
-                    dirty = true;
-                    application::Application::current_view_type = viewType;
-                    IC_LOG_DEBUG("[View::AppendListeners()] Event type IN_DIR for view type {}.", std::string(magic_enum::enum_name(viewType)));
-                }
-            })
-    );
+    bus.SetHandler(event::IcEventType::UP_DIR, viewType, [this](event::IcEvent&& t_event) {
+        ChangePath(t_event.path.parent_path());
+        IC_LOG_DEBUG("[View::AppendListeners()] Event type UP_DIR for view type {}.", std::string(magic_enum::enum_name(viewType)));
+    });
 
-    application::Application::event_dispatcher.appendListener(
-        event::IcEventType::SHOW_PATH_INFO,
-        eventpp::argumentAdapter<void(const event::ShowPathInfoEvent&)>(
-            [this](const event::ShowPathInfoEvent& t_event) {
-                if (!t_event.path.empty() && t_event.viewType == viewType)
-                {
-                    currentSelectedPath = t_event.path;
-                    application::Application::current_view_type = viewType;
-                    IC_LOG_DEBUG("[View::AppendListeners()] Event type SHOW_PATH_INFO for view type {}.", std::string(magic_enum::enum_name(viewType)));
-                }
-            })
-    );
+    bus.SetHandler(event::IcEventType::IN_DIR, viewType, [this](event::IcEvent&& t_event) {
+        ChangePath(std::move(t_event.path));
+        IC_LOG_DEBUG("[View::AppendListeners()] Event type IN_DIR for view type {}.", std::string(magic_enum::enum_name(viewType)));
+    });
 
-    application::Application::event_dispatcher.appendListener(
-        event::IcEventType::CHANGE_ROOT_PATH,
-        eventpp::argumentAdapter<void(const event::ChangeRootPathEvent&)>(
-            [this](const event::ChangeRootPathEvent& t_event) {
-                if (!t_event.path.empty() && t_event.viewType == viewType)
-                {
-                    currentPath = t_event.path;
-                    currentSelectedPath.clear();
-                    entries.filesAndDirs.clear();
-                    selectedEntries.clear();
-                    dirty = true;
-                    application::Application::current_view_type = viewType;
-                    IC_LOG_DEBUG("[View::AppendListeners()] Event type CHANGE_ROOT_PATH for view type {}.", std::string(magic_enum::enum_name(viewType)));
-                }
-            })
-    );
+    bus.SetHandler(event::IcEventType::SHOW_PATH_INFO, viewType, [this](event::IcEvent&& t_event) {
+        currentSelectedPath = std::move(t_event.path);
+        application::Application::current_view_type = viewType;
+        IC_LOG_DEBUG("[View::AppendListeners()] Event type SHOW_PATH_INFO for view type {}.", std::string(magic_enum::enum_name(viewType)));
+    });
 
-    application::Application::event_dispatcher.appendListener(
-        event::IcEventType::DIRTY,
-        eventpp::argumentAdapter<void(const event::DirtyEvent&)>(
-            [this](const event::DirtyEvent& t_event) {
-                if (!t_event.path.empty() && t_event.viewType == viewType)
-                {
-                    currentPath = t_event.path;
-                    currentSelectedPath.clear();
-                    entries.filesAndDirs.clear();
-                    selectedEntries.clear();
-                    dirty = true;
-                    application::Application::current_view_type = viewType;
-                    IC_LOG_DEBUG("[View::AppendListeners()] Event type DIRTY for view type {}.", std::string(magic_enum::enum_name(viewType)));
-                }
-            })
-    );
+    bus.SetHandler(event::IcEventType::CHANGE_ROOT_PATH, viewType, [this](event::IcEvent&& t_event) {
+        ChangePath(std::move(t_event.path));
+        IC_LOG_DEBUG("[View::AppendListeners()] Event type CHANGE_ROOT_PATH for view type {}.", std::string(magic_enum::enum_name(viewType)));
+    });
 
-    application::Application::event_dispatcher.appendListener(
-        event::IcEventType::SELECT_PATH,
-        eventpp::argumentAdapter<void(const event::SelectPathEvent&)>(
-            [this](const event::SelectPathEvent& t_event) {
-                if (!t_event.path.empty() && t_event.viewType == viewType)
-                {
-                    if (selectedEntries.contains(t_event.path))
-                    {
-                        selectedEntries.erase(t_event.path);
-                    }
-                    else
-                    {
-                        selectedEntries.emplace(t_event.path);
-                    }
-
-                    application::Application::current_view_type = viewType;
-                    IC_LOG_DEBUG("[View::AppendListeners()] Event type SELECT_PATH for view type {}.", std::string(magic_enum::enum_name(viewType)));
-                }
-            })
-    );
+    bus.SetHandler(event::IcEventType::DIRTY, viewType, [this](event::IcEvent&& t_event) {
+        currentPath = std::move(t_event.path);
+        // a rescan never uses a cached listing
+        application::Application::listing_cache.Remove(currentPath);
+        Reset();
+        IC_LOG_DEBUG("[View::AppendListeners()] Event type DIRTY for view type {}.", std::string(magic_enum::enum_name(viewType)));
+    });
+
+    bus.SetHandler(event::IcEventType::SELECT_PATH, viewType, [this](event::IcEvent&& t_event) {
+        if (const auto it{ selectedEntries.find(t_event.path) }; it != selectedEntries.end())
+        {
+            selectedEntries.erase(it);
+        }
+        else
+        {
+            selectedEntries.emplace(std::move(t_event.path));
+        }
+
+        application::Application::current_view_type = viewType;
+        IC_LOG_DEBUG("[View::AppendListeners()] Event type SELECT_PATH for view type {}.", std::string(magic_enum::enum_name(viewType)));
+    });
+}
+
+void ic::data::View::ChangePath(std::filesystem::path t_path)
+{
+    StoreListing();
+    currentPath = std::move(t_path);
+    filterQuery.clear();
+    Reset();
+}
+
+void ic::data::View::Reset()
+{
+    currentSelectedPath.clear();
+    m_scanner->Cancel();
+    m_sorter->Cancel();
+    m_sizer->Clear();
+    m_refreshNames.clear();
+    entries.Clear();
+    selectedEntries.clear();
+    dirty = true;
+    application::Application::current_view_type = viewType;
 }
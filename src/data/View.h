@@ -21,7 +21,12 @@
 #include <memory>
 #include <unordered_set>
 #include "Entries.h"
-#include "Comparator.h"
+#include "Scanner.h"
+#include "DirectoryWatcher.h"
+#include "ListingCache.h"
+#include "QuickFilter.h"
+#include "DirectorySizer.h"
+#include "Sorter.h"
 
 namespace ic::widget
 {
@@ -51,7 +56,7 @@ namespace ic::data
         /**
          * Files and directories relative to the currentPath.
          */
-        Entries<PathComparator> entries;
+        Entries entries;
 
         /**
          * Path to the current working directory.
@@ -73,6 +78,11 @@ namespace ic::data
          */
         std::unordered_set<std::filesystem::path> selectedEntries;
 
+        /**
+         * Only entries whose name contains this text are shown.
+         */
+        std::string filterQuery;
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -97,6 +107,46 @@ namespace ic::data
         void SetInfoPosition(float t_x, float t_y) const;
         void SetInfoSize(float t_x, float t_y) const;
 
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Checks whether the entries of the currentPath are still being read.
+         *
+         * @return True if a scan is running.
+         */
+        [[nodiscard]] bool IsScanning() const;
+
+        /**
+         * Checks whether the entries or the directory sizes are still changing.
+         *
+         * @return True if the View has to be rendered again soon.
+         */
+        [[nodiscard]] bool IsBusy() const;
+
+        /**
+         * Checks whether changes in the currentPath are applied automatically.
+         *
+         * @return True if the currentPath is watched.
+         */
+        [[nodiscard]] bool IsWatching() const;
+
+        /**
+         * @return The rows that match the filterQuery.
+         */
+        [[nodiscard]] const QuickFilter& GetFilter() const;
+
+        /**
+         * @return The totals of the directories whose sizes were requested.
+         */
+        [[nodiscard]] const DirectorySizer& GetDirectorySizer() const;
+
+        /**
+         * @return The requested order of the entries; the rows may not be sorted by it yet.
+         */
+        [[nodiscard]] const SortSpec& GetSortSpec() const { return m_sortSpec; }
+
         //-------------------------------------------------
         // Logic
         //-------------------------------------------------
@@ -104,6 +154,33 @@ namespace ic::data
         void Update();
         void Render() const;
 
+        /**
+         * Requests another order of the entries. The entries are not read again;
+         * Update() sorts the rows in the background and swaps them in when done.
+         *
+         * @param t_sortSpec The new order.
+         */
+        void RequestSort(const SortSpec& t_sortSpec);
+
+        /**
+         * Computes the sizes of the selected directories or,
+         * if nothing is selected, of all directories in the background.
+         */
+        void ComputeDirectorySizes();
+
+        /**
+         * Stops computing the directory sizes.
+         */
+        void CancelDirectorySizes();
+
+        /**
+         * Reads some entries of the currentPath again, e.g. after a file operation.
+         * The entries are read as soon as no scan is running.
+         *
+         * @param t_names The names of the entries that were created, changed or removed.
+         */
+        void Refresh(std::vector<std::string> t_names);
+
     protected:
 
     private:
@@ -121,10 +198,87 @@ namespace ic::data
          */
         std::unique_ptr<widget::InfoWidget> m_infoWidget;
 
+        /**
+         * Reads the entries of the currentPath in the background.
+         */
+        std::unique_ptr<Scanner> m_scanner;
+
+        /**
+         * Watches the currentPath for changes.
+         */
+        std::unique_ptr<DirectoryWatcher> m_watcher;
+
+        /**
+         * Applies the filterQuery to the entries.
+         */
+        std::unique_ptr<QuickFilter> m_filter;
+
+        /**
+         * Computes the sizes of the directories on demand.
+         */
+        std::unique_ptr<DirectorySizer> m_sizer;
+
+        /**
+         * Sorts the rows in the background. The entries are not changed meanwhile.
+         */
+        std::unique_ptr<Sorter> m_sorter;
+
+        /**
+         * Is set when all entries of the currentPath have been received.
+         */
+        bool m_complete{ false };
+
+        /**
+         * The names passed to Refresh() that are not read yet.
+         */
+        std::vector<std::string> m_refreshNames;
+
+        /**
+         * The order requested by RequestSort().
+         */
+        SortSpec m_sortSpec;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Applies the entries received from the scanner and the changes of the currentPath.
+         */
+        void UpdateEntries();
+
+        void RemoveEntries(const std::vector<std::string>& t_names, const std::vector<Scanner::Batch>& t_batches);
+
+        /**
+         * Moves the complete entries of the currentPath into the listing cache.
+         */
+        void StoreListing();
+
+        /**
+         * Takes the entries of the currentPath from the listing cache.
+         *
+         * @return True if the entries were cached.
+         */
+        bool RestoreListing();
+
+        void StartScan();
+
         //-------------------------------------------------
         // Listeners
         //-------------------------------------------------
 
         void AppendListeners();
+
+        /**
+         * Leaves the currentPath. Its entries are kept in the listing cache.
+         *
+         * @param t_path The new currentPath.
+         */
+        void ChangePath(std::filesystem::path t_path);
+
+        /**
+         * Drops the entries and the selection, so that the currentPath is read again.
+         */
+        void Reset();
     };
 }
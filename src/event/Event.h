@@ -38,27 +38,34 @@ namespace ic::event
         SHOW_PATH_INFO,
         CHANGE_ROOT_PATH,
         DIRTY,
-        SELECT_PATH
+        SELECT_PATH,
+        HOVER_PATH
     };
 
     //-------------------------------------------------
     // Event base class
     //-------------------------------------------------
 
+    /**
+     * The events only set the type, so they can be queued as an IcEvent.
+     */
     struct IcEvent
     {
         std::filesystem::path path;
         data::ViewType viewType{ data::ViewType::NONE };
         IcEventType eventType{ IcEventType::NONE };
 
+        /**
+         * The path is a directory; set by the ShowPathInfoEvent, so listeners need no stat.
+         */
+        bool directory{ false };
+
         IcEvent() = default;
 
         IcEvent(std::filesystem::path t_path, data::ViewType t_viewType)
             : path{ std::move(t_path) }
             , viewType{ t_viewType }
         {}
-
-        virtual ~IcEvent() noexcept = default;
     };
 
     //-------------------------------------------------
@@ -85,10 +92,11 @@ namespace ic::event
 
     struct ShowPathInfoEvent: IcEvent
     {
-        ShowPathInfoEvent(std::filesystem::path t_path, data::ViewType t_viewType)
+        ShowPathInfoEvent(std::filesystem::path t_path, data::ViewType t_viewType, const bool t_directory)
             : IcEvent(std::move(t_path), t_viewType)
         {
             eventType = IcEventType::SHOW_PATH_INFO;
+            directory = t_directory;
         }
     };
 
@@ -124,4 +132,13 @@ namespace ic::event
             eventType = IcEventType::SELECT_PATH;
         }
     };
+
+    struct HoverPathEvent: IcEvent
+    {
+        HoverPathEvent(std::filesystem::path t_path, data::ViewType t_viewType)
+            : IcEvent(std::move(t_path), t_viewType)
+        {
+            eventType = IcEventType::HOVER_PATH;
+        }
+    };
 }
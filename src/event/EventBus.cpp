@@ -0,0 +1,121 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "EventBus.h"
+#include "Log.h"
+#include "IcProfile.h"
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool ic::event::EventBus::HasPending() const
+{
+    return !m_queue.empty();
+}
+
+//-------------------------------------------------
+// Setter
+//-------------------------------------------------
+
+void ic::event::EventBus::SetHandler(const IcEventType t_eventType, const data::ViewType t_viewType, Handler t_handler)
+{
+    m_handlers[magic_enum::enum_integer(t_eventType)][magic_enum::enum_integer(t_viewType)] = std::move(t_handler);
+}
+
+void ic::event::EventBus::AppendListener(const IcEventType t_eventType, Listener t_listener)
+{
+    m_listeners[magic_enum::enum_integer(t_eventType)].push_back(std::move(t_listener));
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::event::EventBus::Publish(IcEvent&& t_event)
+{
+    if (t_event.path.empty())
+    {
+        IC_LOG_WARN("[EventBus::Publish()] Event type {} without a path is ignored.", std::string(magic_enum::enum_name(t_event.eventType)));
+        return;
+    }
+
+    if (!Coalesce(t_event))
+    {
+        m_queue.push_back(std::move(t_event));
+    }
+}
+
+void ic::event::EventBus::Drain()
+{
+    IC_PROFILE_SCOPE("EventBus::Drain");
+
+    // a handler may publish again: these events wait for the next frame
+    m_draining.swap(m_queue);
+
+    for (auto& event : m_draining)
+    {
+        const auto eventType{ magic_enum::enum_integer(event.eventType) };
+
+        for (const auto& listener : m_listeners[eventType])
+        {
+            listener(event);
+        }
+
+        if (const auto& handler{ m_handlers[eventType][magic_enum::enum_integer(event.viewType)] })
+        {
+            handler(std::move(event));
+        }
+    }
+
+    m_draining.clear();
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+bool ic::event::EventBus::Coalesce(IcEvent& t_event)
+{
+    // only the last event of the view is compared, so the order of the events is kept
+    const auto last{ std::ranges::find(m_queue.rbegin(), m_queue.rend(), t_event.viewType, &IcEvent::viewType) };
+    if (last == m_queue.rend() || last->eventType != t_event.eventType)
+    {
+        return false;
+    }
+
+    switch (t_event.eventType)
+    {
+    case IcEventType::SELECT_PATH:
+        // the second toggle undoes the first
+        if (last->path == t_event.path)
+        {
+            m_queue.erase(std::next(last).base());
+            return true;
+        }
+        return false;
+    case IcEventType::SHOW_PATH_INFO:
+    case IcEventType::HOVER_PATH:
+        // only the latest path is of interest
+        *last = std::move(t_event);
+        return true;
+    default:
+        return last->path == t_event.path;
+    }
+}
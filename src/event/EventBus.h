@@ -0,0 +1,145 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <vector>
+#include "Event.h"
+#include "vendor/magic/magic_enum.hpp"
+
+namespace ic::event
+{
+    /**
+     * Queues the events raised while rendering and delivers them once per frame,
+     * so that the data of a View never changes in the middle of a render.
+     * Must only be used from the UI thread.
+     */
+    class EventBus
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * Owns an event. Only one Handler per event type and view type.
+         */
+        using Handler = std::function<void(IcEvent&&)>;
+
+        /**
+         * Observes the events of all views. Is called before the Handler.
+         */
+        using Listener = std::function<void(const IcEvent&)>;
+
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr auto EVENT_TYPES{ magic_enum::enum_count<IcEventType>() };
+        static constexpr auto VIEW_TYPES{ magic_enum::enum_count<data::ViewType>() };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        EventBus() = default;
+
+        EventBus(const EventBus& t_other) = delete;
+        EventBus(EventBus&& t_other) noexcept = delete;
+        EventBus& operator=(const EventBus& t_other) = delete;
+        EventBus& operator=(EventBus&& t_other) noexcept = delete;
+
+        ~EventBus() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @return True if events are waiting for the next Drain().
+         */
+        [[nodiscard]] bool HasPending() const;
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * Sets the Handler of the events of the given type addressed to a view.
+         *
+         * @param t_eventType The event type.
+         * @param t_viewType The view type.
+         * @param t_handler The Handler.
+         */
+        void SetHandler(IcEventType t_eventType, data::ViewType t_viewType, Handler t_handler);
+
+        /**
+         * Adds a Listener for the events of the given type.
+         *
+         * @param t_eventType The event type.
+         * @param t_listener The Listener.
+         */
+        void AppendListener(IcEventType t_eventType, Listener t_listener);
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Queues an event. An event that repeats or supersedes the
+         * last queued event of the same view is merged with it.
+         *
+         * @param t_event The event.
+         */
+        void Publish(IcEvent&& t_event);
+
+        /**
+         * Delivers the queued events in order. Events published
+         * meanwhile are delivered with the next call.
+         */
+        void Drain();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        std::array<std::array<Handler, VIEW_TYPES>, EVENT_TYPES> m_handlers;
+        std::array<std::vector<Listener>, EVENT_TYPES> m_listeners;
+
+        std::vector<IcEvent> m_queue;
+        std::vector<IcEvent> m_draining;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Merges an event with the last queued event of the same view.
+         *
+         * @param t_event The event.
+         *
+         * @return True if the event is merged and must not be queued.
+         */
+        bool Coalesce(IcEvent& t_event);
+    };
+}
@@ -0,0 +1,165 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "ConcurrencyController.h"
+#include "Log.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::operation::ConcurrencyController::ConcurrencyController(Progress& t_progress)
+    : m_progress{ t_progress }
+    , m_windowStart{ std::chrono::steady_clock::now() }
+{
+    IC_LOG_DEBUG("[ConcurrencyController::ConcurrencyController()] Create ConcurrencyController.");
+
+    m_progress.concurrency = m_limit;
+}
+
+ic::operation::ConcurrencyController::~ConcurrencyController() noexcept
+{
+    IC_LOG_DEBUG("[ConcurrencyController::~ConcurrencyController()] Destruct ConcurrencyController.");
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+std::size_t ic::operation::ConcurrencyController::GetLimit() const
+{
+    std::scoped_lock lock{ m_mutex };
+
+    return m_limit;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+bool ic::operation::ConcurrencyController::Acquire(const std::stop_token& t_stopToken)
+{
+    std::unique_lock lock{ m_mutex };
+    if (!m_released.wait(lock, t_stopToken, [this] { return m_inFlight < m_limit; }))
+    {
+        return false;
+    }
+
+    // the first window starts with the first file
+    if (m_inFlight == 0 && m_windowFiles == 0)
+    {
+        m_windowStart = std::chrono::steady_clock::now();
+        m_windowCost = GetCost();
+    }
+
+    ++m_inFlight;
+    m_windowLimited = m_windowLimited || m_inFlight == m_limit;
+
+    return true;
+}
+
+void ic::operation::ConcurrencyController::Release(const std::chrono::steady_clock::duration t_latency)
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        --m_inFlight;
+        ++m_windowFiles;
+        m_windowLatency += t_latency;
+
+        Adjust();
+    }
+
+    m_released.notify_all();
+}
+
+void ic::operation::ConcurrencyController::Update()
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        Adjust();
+    }
+
+    m_released.notify_all();
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+std::uint64_t ic::operation::ConcurrencyController::GetCost() const
+{
+    return m_progress.bytes + m_progress.files * FILE_COST;
+}
+
+void ic::operation::ConcurrencyController::Adjust()
+{
+    const auto now{ std::chrono::steady_clock::now() };
+    if (now - m_windowStart < WINDOW)
+    {
+        return;
+    }
+
+    const auto cost{ GetCost() };
+    const auto windowCost{ static_cast<double>(cost - std::min(cost, m_windowCost)) };
+    const auto seconds{ std::chrono::duration<double>(now - m_windowStart).count() };
+    const auto files{ m_windowFiles };
+    const auto limited{ m_windowLimited || m_inFlight == m_limit };
+    const auto latency{ std::chrono::duration<double>(m_windowLatency).count() / std::max(windowCost, 1.0) };
+
+    m_windowStart = now;
+    m_windowCost = cost;
+    m_windowFiles = 0;
+    m_windowLatency = std::chrono::steady_clock::duration::zero();
+    m_windowLimited = false;
+
+    // a window stretched by a pause says nothing about the device
+    if (seconds > std::chrono::duration<double>(WINDOW).count() * 8.0)
+    {
+        return;
+    }
+
+    const auto throughput{ windowCost / seconds };
+    const auto dropped{ throughput < m_lastThroughput * 0.9 };
+
+    // the latency is only known from finished files
+    auto queueing{ false };
+    if (files > 0)
+    {
+        m_baseLatency = m_baseLatency > 0.0 ? std::min(m_baseLatency, latency) : latency;
+        queueing = latency > m_baseLatency * 2.0 && throughput < m_lastThroughput * 1.05;
+    }
+
+    const auto previous{ m_limit };
+    if (m_lastThroughput > 0.0 && (dropped || queueing))
+    {
+        m_limit = std::max(MIN_LIMIT, m_limit * 3 / 4);
+    }
+    else if (limited)
+    {
+        m_limit = std::min(MAX_LIMIT, m_limit + 1);
+    }
+
+    m_lastThroughput = throughput;
+    m_progress.concurrency = m_limit;
+
+    if (m_limit != previous)
+    {
+        IC_LOG_DEBUG("[ConcurrencyController::Adjust()] {:.1f} MiB/s, concurrency {} -> {}.", throughput / (1024.0 * 1024.0), previous, m_limit);
+    }
+}
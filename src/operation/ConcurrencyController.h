@@ -0,0 +1,152 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+#include <chrono>
+#include "Operation.h"
+
+namespace ic::operation
+{
+    /**
+     * Chooses the number of files copied at the same time, like the congestion control of TCP.
+     * The throughput is measured in windows; as long as it does not drop, the limit is raised by one.
+     * If it drops, or the time per byte grows without a gain in throughput, the limit is cut by a quarter.
+     * Many small files on a fast SSD end up with many parallel copies, a spinning disk with few.
+     */
+    class ConcurrencyController
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::size_t MIN_LIMIT{ 1 };
+        static constexpr std::size_t MAX_LIMIT{ 16 };
+        static constexpr std::size_t INITIAL_LIMIT{ 4 };
+
+        /**
+         * The minimum duration of a measurement.
+         */
+        static constexpr std::chrono::milliseconds WINDOW{ 250 };
+
+        /**
+         * A file counts like this many bytes, because creating and closing it takes time as well.
+         */
+        static constexpr std::uint64_t FILE_COST{ 64 * 1024 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        ConcurrencyController() = delete;
+
+        /**
+         * @param t_progress The progress to measure; the chosen limit is written to it.
+         */
+        explicit ConcurrencyController(Progress& t_progress);
+
+        ConcurrencyController(const ConcurrencyController& t_other) = delete;
+        ConcurrencyController(ConcurrencyController&& t_other) noexcept = delete;
+        ConcurrencyController& operator=(const ConcurrencyController& t_other) = delete;
+        ConcurrencyController& operator=(ConcurrencyController&& t_other) noexcept = delete;
+
+        ~ConcurrencyController() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] std::size_t GetLimit() const;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Waits until another file may be copied.
+         *
+         * @param t_stopToken To cancel waiting.
+         *
+         * @return False if stopped; Release() must not be called then.
+         */
+        bool Acquire(const std::stop_token& t_stopToken);
+
+        /**
+         * Reports a finished file.
+         *
+         * @param t_latency The time it took to copy the file.
+         */
+        void Release(std::chrono::steady_clock::duration t_latency);
+
+        /**
+         * Ends the current window if it is due, also if no file was finished,
+         * so that the limit follows the throughput of large files.
+         */
+        void Update();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        Progress& m_progress;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable_any m_released;
+
+        std::size_t m_limit{ INITIAL_LIMIT };
+        std::size_t m_inFlight{ 0 };
+
+        std::chrono::steady_clock::time_point m_windowStart;
+        std::uint64_t m_windowCost{ 0 };
+        std::size_t m_windowFiles{ 0 };
+        std::chrono::steady_clock::duration m_windowLatency{ 0 };
+
+        /**
+         * Set if all allowed files were in flight during the window; otherwise raising the limit does not help.
+         */
+        bool m_windowLimited{ false };
+
+        /**
+         * The throughput of the last window, in cost per second.
+         */
+        double m_lastThroughput{ 0.0 };
+
+        /**
+         * The lowest latency per cost seen so far; more than twice as much means the device is queueing.
+         */
+        double m_baseLatency{ 0.0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        [[nodiscard]] std::uint64_t GetCost() const;
+
+        /**
+         * Ends the window, if it is due, and adjusts the limit. The mutex must be locked.
+         */
+        void Adjust();
+    };
+}
@@ -0,0 +1,495 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include <deque>
+#include <ranges>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "CopyOperation.h"
+#include "Log.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+    #include <sys/sendfile.h>
+    #include <cerrno>
+#endif
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::operation::CopyOperation::CopyOperation(std::vector<std::filesystem::path> t_sources, std::filesystem::path t_target)
+    : CopyOperation(
+        "Copy",
+        std::move(t_sources),
+        std::move(t_target),
+        Priority::LOW
+    )
+{
+}
+
+ic::operation::CopyOperation::CopyOperation(
+    const std::string_view t_verb,
+    std::vector<std::filesystem::path> t_sources,
+    std::filesystem::path t_target,
+    const Priority t_priority
+)
+    : Operation(t_verb, std::move(t_sources), std::move(t_target), t_priority)
+{
+    IC_LOG_DEBUG("[CopyOperation::CopyOperation()] Create CopyOperation.");
+}
+
+ic::operation::CopyOperation::~CopyOperation() noexcept
+{
+    IC_LOG_DEBUG("[CopyOperation::~CopyOperation()] Destruct CopyOperation.");
+}
+
+//-------------------------------------------------
+// Run
+//-------------------------------------------------
+
+void ic::operation::CopyOperation::Run(const std::stop_token& t_stopToken)
+{
+    // everything is listed first, so that the progress has a total
+    std::vector<std::vector<Item>> plans;
+    for (const auto& source : m_sources)
+    {
+        if (std::vector<Item> items; CanCopy(source) && Plan(t_stopToken, source, m_target / source.filename(), items))
+        {
+            plans.push_back(std::move(items));
+        }
+    }
+
+    for (const auto& items : plans)
+    {
+        if (!Proceed(t_stopToken))
+        {
+            return;
+        }
+
+        Copy(t_stopToken, items);
+    }
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+bool ic::operation::CopyOperation::CanCopy(const std::filesystem::path& t_source)
+{
+    const auto target{ m_target / t_source.filename() };
+
+    std::error_code ec;
+    if (std::filesystem::exists(std::filesystem::symlink_status(target, ec)))
+    {
+        AddError(target, "already exists");
+        return false;
+    }
+
+    // a directory cannot be copied into itself
+    const auto source{ std::filesystem::weakly_canonical(t_source, ec) };
+    if (ec)
+    {
+        AddError(t_source, ec);
+        return false;
+    }
+
+    const auto directory{ std::filesystem::weakly_canonical(m_target, ec) };
+    if (ec)
+    {
+        AddError(m_target, ec);
+        return false;
+    }
+
+    if (std::mismatch(source.begin(), source.end(), directory.begin(), directory.end()).first == source.end())
+    {
+        AddError(t_source, "contains the target directory");
+        return false;
+    }
+
+    return true;
+}
+
+bool ic::operation::CopyOperation::Plan(
+    const std::stop_token& t_stopToken,
+    const std::filesystem::path& t_source,
+    const std::filesystem::path& t_target,
+    std::vector<Item>& t_items
+)
+{
+    const auto add{ [&](const std::filesystem::path& t_path, const std::filesystem::file_status t_status, const std::uint64_t t_size) {
+        Item item{ t_path, t_target / t_path.lexically_relative(t_source), ItemType::FILE, t_size, t_status.permissions() };
+        if (t_path == t_source)
+        {
+            item.target = t_target;
+        }
+
+        if (std::filesystem::is_symlink(t_status))
+        {
+            item.type = ItemType::SYMLINK;
+        }
+        else if (std::filesystem::is_directory(t_status))
+        {
+            item.type = ItemType::DIRECTORY;
+        }
+        else if (!std::filesystem::is_regular_file(t_status))
+        {
+            AddError(t_path, "is not a regular file, directory or symlink");
+            return;
+        }
+
+        if (item.type != ItemType::DIRECTORY)
+        {
+            ++m_progress.totalFiles;
+            m_progress.totalBytes += item.size;
+        }
+
+        t_items.push_back(std::move(item));
+    } };
+
+    // an unreadable directory would be copied as an empty one
+    const auto readable{ [this](const std::filesystem::path& t_path) {
+        std::error_code dirEc;
+        if (std::filesystem::directory_iterator{ t_path, dirEc }; dirEc)
+        {
+            AddError(t_path, dirEc);
+            return false;
+        }
+
+        return true;
+    } };
+
+    std::error_code ec;
+    const auto status{ std::filesystem::symlink_status(t_source, ec) };
+    if (ec)
+    {
+        AddError(t_source, ec);
+        return false;
+    }
+
+    add(t_source, status, std::filesystem::is_regular_file(status) ? std::filesystem::file_size(t_source, ec) : 0);
+    if (t_items.empty() || t_items.front().type != ItemType::DIRECTORY)
+    {
+        return !t_items.empty();
+    }
+
+    if (!readable(t_source))
+    {
+        t_items.clear();
+        return false;
+    }
+
+    // symlinks to directories are not followed
+    std::filesystem::recursive_directory_iterator it{ t_source, ec };
+    for (const std::filesystem::recursive_directory_iterator end; !ec && it != end && Proceed(t_stopToken); it.increment(ec))
+    {
+        std::error_code entryEc;
+        const auto entryStatus{ it->symlink_status(entryEc) };
+        const auto size{ std::filesystem::is_regular_file(entryStatus) ? it->file_size(entryEc) : 0 };
+        if (entryEc)
+        {
+            AddError(it->path(), entryEc);
+            continue;
+        }
+
+        if (std::filesystem::is_directory(entryStatus) && !readable(it->path()))
+        {
+            it.disable_recursion_pending();
+            continue;
+        }
+
+        add(it->path(), entryStatus, size);
+    }
+
+    if (ec)
+    {
+        AddError(t_source, ec);
+    }
+
+    return true;
+}
+
+bool ic::operation::CopyOperation::Copy(const std::stop_token& t_stopToken, const std::vector<Item>& t_items)
+{
+    // the files are copied by helper threads; directories and symlinks in this thread, in order,
+    // so that a directory exists before the files inside are copied
+    std::mutex mutex;
+    std::condition_variable_any condition;
+    std::deque<const Item*> files;
+    auto done{ false };
+    std::atomic_bool copied{ true };
+
+    auto helper{ [&] {
+        while (true)
+        {
+            const Item* item;
+            {
+                std::unique_lock lock{ mutex };
+                condition.wait(lock, [&] { return !files.empty() || done; });
+                if (files.empty())
+                {
+                    return;
+                }
+
+                item = files.front();
+                files.pop_front();
+            }
+
+            const auto start{ std::chrono::steady_clock::now() };
+            if (t_stopToken.stop_requested() || !CopyRegularFile(t_stopToken, *item))
+            {
+                copied = false;
+            }
+            m_controller.Release(std::chrono::steady_clock::now() - start);
+        }
+    } };
+
+    std::vector<std::jthread> helpers;
+    std::vector<const Item*> directories;
+    for (const auto& item : t_items)
+    {
+        if (!Proceed(t_stopToken))
+        {
+            copied = false;
+            break;
+        }
+
+        std::error_code ec;
+        switch (item.type)
+        {
+        case ItemType::DIRECTORY:
+            // created writable; the permissions of the source are applied when the content is copied
+            if (!std::filesystem::create_directory(item.target, ec) && !ec)
+            {
+                ec = std::make_error_code(std::errc::file_exists);
+            }
+            if (!ec)
+            {
+                directories.push_back(&item);
+            }
+            break;
+        case ItemType::SYMLINK:
+            std::filesystem::copy_symlink(item.source, item.target, ec);
+            if (!ec)
+            {
+                ++m_progress.files;
+            }
+            break;
+        case ItemType::FILE:
+            if (!m_controller.Acquire(t_stopToken))
+            {
+                copied = false;
+                break;
+            }
+
+            {
+                std::scoped_lock lock{ mutex };
+                files.push_back(&item);
+
+                // a helper per allowed file, started when needed
+                if (helpers.size() < m_controller.GetLimit())
+                {
+                    helpers.emplace_back(helper);
+                }
+            }
+            condition.notify_one();
+            break;
+        }
+
+        if (ec)
+        {
+            AddError(item.target, ec);
+            copied = false;
+        }
+
+        // the views show a new directory before its content is copied
+        if (&item == &t_items.front() && item.type != ItemType::FILE)
+        {
+            AddChange(item.target);
+        }
+    }
+
+    {
+        std::scoped_lock lock{ mutex };
+        done = true;
+    }
+    condition.notify_all();
+    helpers.clear();
+
+    // like cp -r: a read-only directory becomes read-only after its content
+    for (const auto* item : std::views::reverse(directories))
+    {
+        std::error_code ec;
+        std::filesystem::permissions(item->target, item->permissions, ec);
+        if (ec)
+        {
+            AddError(item->target, ec);
+            copied = false;
+        }
+    }
+
+    if (t_items.front().type == ItemType::FILE)
+    {
+        AddChange(t_items.front().target);
+    }
+
+    return copied;
+}
+
+bool ic::operation::CopyOperation::CopyRegularFile(const std::stop_token& t_stopToken, const Item& t_item)
+{
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    const auto in{ open(t_item.source.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (in < 0)
+    {
+        AddError(t_item.source, std::error_code(errno, std::system_category()));
+        return false;
+    }
+
+    struct stat st{};
+    fstat(in, &st);
+
+    // never overwrites, the mode is the mode of the source
+    const auto out{ open(t_item.target.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, st.st_mode & 07777) };
+    if (out < 0)
+    {
+        AddError(t_item.target, std::error_code(errno, std::system_category()));
+        close(in);
+        return false;
+    }
+
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // files in /proc or /sys report a size of 0 and can only be read
+    auto error{ CopyData(t_stopToken, in, out, st.st_size > 0) };
+
+    close(in);
+    if (close(out) != 0 && error == 0)
+    {
+        error = errno;
+    }
+
+    if (error != 0 || t_stopToken.stop_requested())
+    {
+        // no partial copy is left behind
+        unlink(t_item.target.c_str());
+        if (error != 0)
+        {
+            AddError(t_item.target, std::error_code(error, std::system_category()));
+        }
+
+        return false;
+    }
+#else
+    if (std::error_code ec; !std::filesystem::copy_file(t_item.source, t_item.target, std::filesystem::copy_options::none, ec))
+    {
+        AddError(t_item.target, ec);
+        return false;
+    }
+
+    m_progress.bytes += t_item.size;
+#endif
+
+    ++m_progress.files;
+
+    return true;
+}
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+int ic::operation::CopyOperation::CopyData(const std::stop_token& t_stopToken, const int t_in, const int t_out, const bool t_inKernel)
+{
+    enum class Method
+    {
+        COPY_FILE_RANGE, SENDFILE, READ_WRITE
+    };
+
+    // each method falls back to the next if the first call fails because of the file systems
+    const auto unsupported{ [](const int t_error) {
+        return t_error == EXDEV || t_error == ENOSYS || t_error == EINVAL || t_error == EOPNOTSUPP;
+    } };
+
+    auto method{ t_inKernel ? Method::COPY_FILE_RANGE : Method::READ_WRITE };
+    std::vector<char> buffer;
+    std::uint64_t copied{ 0 };
+
+    while (Proceed(t_stopToken))
+    {
+        ssize_t bytes;
+        if (method == Method::COPY_FILE_RANGE)
+        {
+            bytes = copy_file_range(t_in, nullptr, t_out, nullptr, CHUNK_SIZE, 0);
+            if (bytes < 0 && copied == 0 && unsupported(errno))
+            {
+                method = Method::SENDFILE;
+                continue;
+            }
+        }
+        else if (method == Method::SENDFILE)
+        {
+            bytes = sendfile(t_out, t_in, nullptr, CHUNK_SIZE);
+            if (bytes < 0 && copied == 0 && unsupported(errno))
+            {
+                method = Method::READ_WRITE;
+                continue;
+            }
+        }
+        else
+        {
+            buffer.resize(BUFFER_SIZE);
+            bytes = read(t_in, buffer.data(), buffer.size());
+            for (ssize_t written{ 0 }; bytes > 0 && written < bytes;)
+            {
+                const auto result{ write(t_out, buffer.data() + written, static_cast<std::size_t>(bytes - written)) };
+                if (result < 0 && errno != EINTR)
+                {
+                    return errno;
+                }
+
+                written += std::max<ssize_t>(result, 0);
+            }
+        }
+
+        if (bytes < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return errno;
+        }
+
+        if (bytes == 0)
+        {
+            return 0;
+        }
+
+        copied += static_cast<std::uint64_t>(bytes);
+        m_progress.bytes += static_cast<std::uint64_t>(bytes);
+
+        // large files are measured while they are copied
+        m_controller.Update();
+    }
+
+    return 0;
+}
+#endif
@@ -0,0 +1,161 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include "Operation.h"
+#include "ConcurrencyController.h"
+
+namespace ic::operation
+{
+    /**
+     * Copies files and directories into a target directory; a bulk operation with low priority.
+     * On Linux the data is copied in the kernel with copy_file_range,
+     * sendfile or, if neither is supported, with read and write.
+     * Several files are copied at the same time; a ConcurrencyController chooses how many.
+     */
+    class CopyOperation : public Operation
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The bytes copied by one copy_file_range or sendfile call; a cancel is noticed after each chunk.
+         */
+        static constexpr std::size_t CHUNK_SIZE{ 16 * 1024 * 1024 };
+
+        /**
+         * The buffer of the read and write fallback.
+         */
+        static constexpr std::size_t BUFFER_SIZE{ 1024 * 1024 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        CopyOperation() = delete;
+
+        /**
+         * @param t_sources The files and directories to copy.
+         * @param t_target The directory to copy into.
+         */
+        CopyOperation(std::vector<std::filesystem::path> t_sources, std::filesystem::path t_target);
+
+        CopyOperation(const CopyOperation& t_other) = delete;
+        CopyOperation(CopyOperation&& t_other) noexcept = delete;
+        CopyOperation& operator=(const CopyOperation& t_other) = delete;
+        CopyOperation& operator=(CopyOperation&& t_other) noexcept = delete;
+
+        ~CopyOperation() noexcept override;
+
+    protected:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        enum class ItemType
+        {
+            FILE, DIRECTORY, SYMLINK
+        };
+
+        /**
+         * Something to copy; a directory always comes before its content.
+         */
+        struct Item
+        {
+            std::filesystem::path source;
+            std::filesystem::path target;
+            ItemType type{ ItemType::FILE };
+            std::uint64_t size{ 0 };
+
+            /**
+             * The permissions of the source, applied to a directory after its content is copied.
+             */
+            std::filesystem::perms permissions{ std::filesystem::perms::unknown };
+        };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        CopyOperation(std::string_view t_verb, std::vector<std::filesystem::path> t_sources, std::filesystem::path t_target, Priority t_priority);
+
+        //-------------------------------------------------
+        // Run
+        //-------------------------------------------------
+
+        void Run(const std::stop_token& t_stopToken) override;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Checks whether a source can be copied to the target directory.
+         *
+         * @param t_source A file or directory.
+         *
+         * @return True if the target does not exist and is not inside the source.
+         */
+        [[nodiscard]] bool CanCopy(const std::filesystem::path& t_source);
+
+        /**
+         * Lists everything below a source and adds the files and bytes to the totals.
+         *
+         * @param t_stopToken To cancel.
+         * @param t_source A file or directory.
+         * @param t_target The path of the copy.
+         * @param t_items Receives the items; the source is the first.
+         *
+         * @return False if the source cannot be read. Unreadable directories below are reported and skipped.
+         */
+        bool Plan(const std::stop_token& t_stopToken, const std::filesystem::path& t_source, const std::filesystem::path& t_target, std::vector<Item>& t_items);
+
+        /**
+         * Copies the items of one source. Waits for all files.
+         *
+         * @param t_stopToken To cancel.
+         * @param t_items The items created by Plan().
+         *
+         * @return True if everything was copied.
+         */
+        bool Copy(const std::stop_token& t_stopToken, const std::vector<Item>& t_items);
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        ConcurrencyController m_controller{ m_progress };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        bool CopyRegularFile(const std::stop_token& t_stopToken, const Item& t_item);
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+        /**
+         * @return 0 or an errno value.
+         */
+        int CopyData(const std::stop_token& t_stopToken, int t_in, int t_out, bool t_inKernel);
+#endif
+    };
+}
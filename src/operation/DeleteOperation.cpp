@@ -0,0 +1,350 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <ranges>
+#include "DeleteOperation.h"
+#include "Log.h"
+#include "application/Util.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include "data/GetdentsReader.h"
+#endif
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::operation::DeleteOperation::DeleteOperation(std::vector<std::filesystem::path> t_sources)
+    : Operation(
+        "Delete",
+        std::move(t_sources),
+        {},
+        Priority::NORMAL
+    )
+{
+    IC_LOG_DEBUG("[DeleteOperation::DeleteOperation()] Create DeleteOperation.");
+}
+
+ic::operation::DeleteOperation::~DeleteOperation() noexcept
+{
+    IC_LOG_DEBUG("[DeleteOperation::~DeleteOperation()] Destruct DeleteOperation.");
+}
+
+//-------------------------------------------------
+// Run
+//-------------------------------------------------
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+
+void ic::operation::DeleteOperation::Run(const std::stop_token& t_stopToken)
+{
+    std::vector<std::shared_ptr<Directory>> directories;
+    for (const auto& source : m_sources)
+    {
+        // a symlink to a directory is removed, not its target
+        if (unlinkat(AT_FDCWD, source.c_str(), 0) == 0)
+        {
+            ++m_progress.files;
+            AddChange(source);
+        }
+        else if (errno == EISDIR)
+        {
+            auto directory{ std::make_shared<Directory>() };
+            directory->name = source.string();
+            directories.push_back(std::move(directory));
+        }
+        else
+        {
+            AddError(source, std::error_code(errno, std::system_category()));
+        }
+    }
+
+    Remove(t_stopToken, std::move(directories));
+}
+
+#else
+
+void ic::operation::DeleteOperation::Run(const std::stop_token& t_stopToken)
+{
+    for (const auto& source : m_sources)
+    {
+        if (!Proceed(t_stopToken))
+        {
+            return;
+        }
+
+        RemoveTree(t_stopToken, source);
+        AddChange(source);
+    }
+}
+
+#endif
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+
+ic::operation::DeleteOperation::Directory::~Directory() noexcept
+{
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+void ic::operation::DeleteOperation::Remove(const std::stop_token& t_stopToken, std::vector<std::shared_ptr<Directory>> t_pending)
+{
+    std::mutex queueMutex;
+    std::condition_variable_any condition;
+    std::size_t active{ 0 };
+
+    auto worker{ [&] {
+        application::Util::LowerThreadPriority();
+
+        std::vector<Entry> entries;
+        std::vector<std::shared_ptr<Directory>> subdirectories;
+
+        while (true)
+        {
+            std::shared_ptr<Directory> directory;
+            {
+                std::unique_lock lock{ queueMutex };
+
+                // finished when no directory is pending and no worker can add one
+                condition.wait(lock, t_stopToken, [&] { return !t_pending.empty() || active == 0; });
+                if (t_stopToken.stop_requested() || t_pending.empty())
+                {
+                    return;
+                }
+
+                directory = std::move(t_pending.back());
+                t_pending.pop_back();
+                ++active;
+            }
+
+            subdirectories.clear();
+            Empty(t_stopToken, directory, entries, subdirectories);
+
+            {
+                std::scoped_lock lock{ queueMutex };
+                std::ranges::move(subdirectories, std::back_inserter(t_pending));
+                --active;
+            }
+
+            condition.notify_all();
+
+            Finish(t_stopToken, std::move(directory));
+        }
+    } };
+
+    const auto count{ std::clamp(std::thread::hardware_concurrency(), 1u, MAX_THREADS) };
+    std::vector<std::jthread> threads;
+    threads.reserve(count);
+    for (auto i{ 0u }; i < count; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+}
+
+void ic::operation::DeleteOperation::Empty(
+    const std::stop_token& t_stopToken,
+    const std::shared_ptr<Directory>& t_directory,
+    std::vector<Entry>& t_entries,
+    std::vector<std::shared_ptr<Directory>>& t_subdirectories
+)
+{
+    data::GetdentsReader reader{ t_directory->parent ? t_directory->parent->fd : AT_FDCWD, t_directory->name.c_str(), BUFFER_SIZE };
+    if (!reader.IsOpen())
+    {
+        AddError(GetPath(*t_directory), std::error_code(reader.GetError(), std::system_category()));
+        t_directory->failed = true;
+        return;
+    }
+
+    // the directory is read completely before anything is removed, as readdir may skip entries otherwise
+    t_entries.clear();
+    while (!t_stopToken.stop_requested() && reader.Read([&](const std::string_view t_name, const unsigned char t_type) {
+        t_entries.push_back({ std::string(t_name), t_type });
+    }))
+    {
+    }
+
+    if (reader.GetError() != 0)
+    {
+        AddError(GetPath(*t_directory), std::error_code(reader.GetError(), std::system_category()));
+        t_directory->failed = true;
+        return;
+    }
+
+    for (const auto& entry : t_entries)
+    {
+        if (!Proceed(t_stopToken))
+        {
+            return;
+        }
+
+        // an unknown d_type is found out by trying to unlink the entry
+        if (entry.type != DT_DIR)
+        {
+            if (unlinkat(reader.GetFd(), entry.name.c_str(), 0) == 0)
+            {
+                ++m_progress.files;
+                continue;
+            }
+
+            if (errno != EISDIR)
+            {
+                if (errno != ENOENT)
+                {
+                    AddError(GetPath(*t_directory, entry.name), std::error_code(errno, std::system_category()));
+                    t_directory->failed = true;
+                }
+                continue;
+            }
+        }
+
+        auto subdirectory{ std::make_shared<Directory>() };
+        subdirectory->parent = t_directory;
+        subdirectory->name = entry.name;
+        ++t_directory->pending;
+        t_subdirectories.push_back(std::move(subdirectory));
+    }
+
+    if (!t_subdirectories.empty())
+    {
+        t_directory->fd = reader.Release();
+    }
+}
+
+void ic::operation::DeleteOperation::Finish(const std::stop_token& t_stopToken, std::shared_ptr<Directory> t_directory)
+{
+    // after a cancel the directories are not empty; they are closed when the last reference is gone
+    if (t_stopToken.stop_requested())
+    {
+        return;
+    }
+
+    while (t_directory && --t_directory->pending == 0)
+    {
+        if (t_directory->fd >= 0)
+        {
+            close(t_directory->fd);
+            t_directory->fd = -1;
+        }
+
+        const auto& parent{ t_directory->parent };
+        if (!t_directory->failed &&
+            unlinkat(parent ? parent->fd : AT_FDCWD, t_directory->name.c_str(), AT_REMOVEDIR) != 0 &&
+            errno != ENOENT)
+        {
+            AddError(GetPath(*t_directory), std::error_code(errno, std::system_category()));
+            t_directory->failed = true;
+        }
+
+        if (!parent)
+        {
+            AddChange(t_directory->name);
+        }
+        else if (t_directory->failed)
+        {
+            parent->failed = true;
+        }
+
+        t_directory = parent;
+    }
+}
+
+std::filesystem::path ic::operation::DeleteOperation::GetPath(const Directory& t_directory, const std::string_view t_name)
+{
+    std::vector<const std::string*> names;
+    for (const auto* directory{ &t_directory }; directory; directory = directory->parent.get())
+    {
+        names.push_back(&directory->name);
+    }
+
+    std::filesystem::path path;
+    for (const auto* name : std::views::reverse(names))
+    {
+        path /= *name;
+    }
+
+    if (!t_name.empty())
+    {
+        path /= t_name;
+    }
+
+    return path;
+}
+
+#else
+
+void ic::operation::DeleteOperation::RemoveTree(const std::stop_token& t_stopToken, const std::filesystem::path& t_path)
+{
+    std::error_code ec;
+    std::vector<std::filesystem::path> paths{ t_path };
+
+    // symlinks to directories are not followed
+    if (std::filesystem::is_directory(std::filesystem::symlink_status(t_path, ec)))
+    {
+        std::filesystem::recursive_directory_iterator it{ t_path, ec };
+        for (const std::filesystem::recursive_directory_iterator end; !ec && it != end && !t_stopToken.stop_requested(); it.increment(ec))
+        {
+            paths.push_back(it->path());
+        }
+    }
+
+    if (ec)
+    {
+        AddError(t_path, ec);
+        return;
+    }
+
+    // the content of a directory comes after it
+    for (const auto& path : std::views::reverse(paths))
+    {
+        if (!Proceed(t_stopToken))
+        {
+            return;
+        }
+
+        if (std::filesystem::is_directory(std::filesystem::symlink_status(path, ec)))
+        {
+            std::filesystem::remove(path, ec);
+        }
+        else if (std::filesystem::remove(path, ec))
+        {
+            ++m_progress.files;
+        }
+
+        if (ec)
+        {
+            AddError(path, ec);
+        }
+    }
+}
+
+#endif
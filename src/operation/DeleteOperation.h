@@ -0,0 +1,148 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include "Operation.h"
+
+namespace ic::operation
+{
+    /**
+     * Deletes files and directories.
+     * On Linux the directories are read with getdents64 and the entries are removed with unlinkat
+     * relative to the directory; independent subtrees are deleted by several threads.
+     */
+    class DeleteOperation : public Operation
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The maximum number of threads.
+         */
+        static constexpr auto MAX_THREADS{ 8u };
+
+        /**
+         * The getdents64 buffer of each thread.
+         */
+        static constexpr std::size_t BUFFER_SIZE{ 64 * 1024 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        DeleteOperation() = delete;
+
+        /**
+         * @param t_sources The files and directories to delete.
+         */
+        explicit DeleteOperation(std::vector<std::filesystem::path> t_sources);
+
+        DeleteOperation(const DeleteOperation& t_other) = delete;
+        DeleteOperation(DeleteOperation&& t_other) noexcept = delete;
+        DeleteOperation& operator=(const DeleteOperation& t_other) = delete;
+        DeleteOperation& operator=(DeleteOperation&& t_other) noexcept = delete;
+
+        ~DeleteOperation() noexcept override;
+
+    protected:
+        //-------------------------------------------------
+        // Run
+        //-------------------------------------------------
+
+        void Run(const std::stop_token& t_stopToken) override;
+
+    private:
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * A directory that is being emptied.
+         * It is removed when it has been read and all its subdirectories are removed.
+         */
+        struct Directory
+        {
+            std::shared_ptr<Directory> parent;
+
+            /**
+             * The name, or the whole path if there is no parent.
+             */
+            std::string name;
+
+            /**
+             * Kept open while subdirectories are deleted, because they are opened and removed relative to it.
+             */
+            int fd{ -1 };
+
+            /**
+             * The subdirectories not yet removed, plus one until the directory has been read.
+             */
+            std::atomic<std::size_t> pending{ 1 };
+
+            /**
+             * Set if something inside could not be deleted; the directory is kept.
+             */
+            std::atomic<bool> failed{ false };
+
+            ~Directory() noexcept;
+        };
+
+        struct Entry
+        {
+            std::string name;
+            unsigned char type{ 0 };
+        };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Deletes the given directories with a pool of threads.
+         */
+        void Remove(const std::stop_token& t_stopToken, std::vector<std::shared_ptr<Directory>> t_pending);
+
+        /**
+         * Reads a directory, unlinks its files and collects its subdirectories.
+         */
+        void Empty(
+            const std::stop_token& t_stopToken,
+            const std::shared_ptr<Directory>& t_directory,
+            std::vector<Entry>& t_entries,
+            std::vector<std::shared_ptr<Directory>>& t_subdirectories
+        );
+
+        /**
+         * Removes a directory, and its parents, once nothing is pending.
+         */
+        void Finish(const std::stop_token& t_stopToken, std::shared_ptr<Directory> t_directory);
+
+        [[nodiscard]] static std::filesystem::path GetPath(const Directory& t_directory, std::string_view t_name = {});
+#else
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void RemoveTree(const std::stop_token& t_stopToken, const std::filesystem::path& t_path);
+#endif
+    };
+}
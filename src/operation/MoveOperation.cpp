@@ -0,0 +1,171 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <ranges>
+#include "MoveOperation.h"
+#include "Log.h"
+
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    #include <fcntl.h>
+    #include <cstdio>
+    #include <cerrno>
+#endif
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::operation::MoveOperation::MoveOperation(std::vector<std::filesystem::path> t_sources, std::filesystem::path t_target)
+    : CopyOperation(
+        "Move",
+        std::move(t_sources),
+        std::move(t_target),
+        Priority::NORMAL
+    )
+{
+    IC_LOG_DEBUG("[MoveOperation::MoveOperation()] Create MoveOperation.");
+}
+
+ic::operation::MoveOperation::~MoveOperation() noexcept
+{
+    IC_LOG_DEBUG("[MoveOperation::~MoveOperation()] Destruct MoveOperation.");
+}
+
+//-------------------------------------------------
+// Run
+//-------------------------------------------------
+
+void ic::operation::MoveOperation::Run(const std::stop_token& t_stopToken)
+{
+    // the fast path: one rename per source, no matter how big it is
+    std::vector<std::filesystem::path> crossDevice;
+    for (const auto& source : m_sources)
+    {
+        if (!Proceed(t_stopToken))
+        {
+            return;
+        }
+
+        if (!CanCopy(source))
+        {
+            continue;
+        }
+
+        const auto target{ m_target / source.filename() };
+        if (const auto ec{ Rename(source, target) }; ec == std::errc::cross_device_link)
+        {
+            crossDevice.push_back(source);
+        }
+        else if (ec)
+        {
+            AddError(source, ec);
+        }
+        else
+        {
+            ++m_progress.totalFiles;
+            ++m_progress.files;
+
+            AddChange(source);
+            AddChange(target);
+        }
+    }
+
+    // the slow path: copy, compare and delete
+    std::vector<std::vector<Item>> plans;
+    for (const auto& source : crossDevice)
+    {
+        if (std::vector<Item> items; Plan(t_stopToken, source, m_target / source.filename(), items))
+        {
+            plans.push_back(std::move(items));
+        }
+    }
+
+    for (const auto& items : plans)
+    {
+        if (!Proceed(t_stopToken))
+        {
+            return;
+        }
+
+        // nothing is deleted unless everything was copied
+        if (Copy(t_stopToken, items) && !t_stopToken.stop_requested())
+        {
+            RemoveSources(items);
+            AddChange(items.front().source);
+        }
+    }
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+std::error_code ic::operation::MoveOperation::Rename(const std::filesystem::path& t_source, const std::filesystem::path& t_target)
+{
+#if defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
+    if (renameat2(AT_FDCWD, t_source.c_str(), AT_FDCWD, t_target.c_str(), RENAME_NOREPLACE) == 0)
+    {
+        return {};
+    }
+
+    // some file systems do not know RENAME_NOREPLACE; CanCopy() has checked the target
+    if (errno != EINVAL && errno != ENOSYS)
+    {
+        return { errno, std::system_category() };
+    }
+#endif
+
+    std::error_code ec;
+    if (std::filesystem::exists(std::filesystem::symlink_status(t_target, ec)))
+    {
+        return std::make_error_code(std::errc::file_exists);
+    }
+
+    std::filesystem::rename(t_source, t_target, ec);
+
+    return ec;
+}
+
+void ic::operation::MoveOperation::RemoveSources(const std::vector<Item>& t_items)
+{
+    std::error_code ec;
+    for (const auto& item : t_items)
+    {
+        const auto targetStatus{ std::filesystem::symlink_status(item.target, ec) };
+        auto verified{ !ec && std::filesystem::exists(targetStatus) };
+        if (verified && item.type == ItemType::FILE)
+        {
+            verified = std::filesystem::is_regular_file(targetStatus) && std::filesystem::file_size(item.target, ec) == item.size && !ec;
+        }
+
+        if (!verified)
+        {
+            AddError(item.target, "does not match the source, nothing was deleted");
+            return;
+        }
+    }
+
+    // the content of a directory comes after it
+    for (const auto& item : std::views::reverse(t_items))
+    {
+        if (!std::filesystem::remove(item.source, ec) && ec)
+        {
+            AddError(item.source, ec);
+        }
+    }
+}
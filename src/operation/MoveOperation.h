@@ -0,0 +1,83 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include "CopyOperation.h"
+
+namespace ic::operation
+{
+    /**
+     * Moves files and directories into a target directory.
+     * On the same file system each source is renamed, which takes the same time for a file
+     * and for a whole tree. Across file systems the source is copied, compared with the copy
+     * and only then deleted.
+     */
+    class MoveOperation : public CopyOperation
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        MoveOperation() = delete;
+
+        /**
+         * @param t_sources The files and directories to move.
+         * @param t_target The directory to move into.
+         */
+        MoveOperation(std::vector<std::filesystem::path> t_sources, std::filesystem::path t_target);
+
+        MoveOperation(const MoveOperation& t_other) = delete;
+        MoveOperation(MoveOperation&& t_other) noexcept = delete;
+        MoveOperation& operator=(const MoveOperation& t_other) = delete;
+        MoveOperation& operator=(MoveOperation&& t_other) noexcept = delete;
+
+        ~MoveOperation() noexcept override;
+
+    protected:
+        //-------------------------------------------------
+        // Run
+        //-------------------------------------------------
+
+        void Run(const std::stop_token& t_stopToken) override;
+
+    private:
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Renames a source without replacing an existing target.
+         *
+         * @param t_source A file or directory.
+         * @param t_target The new path.
+         *
+         * @return An error code; std::errc::cross_device_link if the source has to be copied.
+         */
+        static std::error_code Rename(const std::filesystem::path& t_source, const std::filesystem::path& t_target);
+
+        /**
+         * Deletes the sources of copied items after comparing them with their copies.
+         * Directories that are not empty, e.g. because something was added in the meantime, are kept.
+         *
+         * @param t_items The items created by Plan().
+         */
+        void RemoveSources(const std::vector<Item>& t_items);
+    };
+}
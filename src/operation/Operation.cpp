@@ -0,0 +1,263 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "Operation.h"
+#include "Log.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::operation::Operation::Operation(
+    const std::string_view t_verb,
+    std::vector<std::filesystem::path> t_sources,
+    std::filesystem::path t_target,
+    const Priority t_priority
+)
+    : m_sources{ std::move(t_sources) }
+    , m_target{ std::move(t_target) }
+    , m_priority{ t_priority }
+{
+    m_description.append(t_verb).append(" ");
+    if (m_sources.size() == 1)
+    {
+        m_description.append(m_sources.front().filename().string());
+    }
+    else
+    {
+        m_description.append(std::to_string(m_sources.size())).append(" entries");
+    }
+
+    if (!m_target.empty())
+    {
+        m_description.append(" to ").append(m_target.string());
+    }
+
+    IC_LOG_DEBUG("[Operation::Operation()] Create Operation: {}.", m_description);
+}
+
+ic::operation::Operation::~Operation() noexcept
+{
+    IC_LOG_DEBUG("[Operation::~Operation()] Destruct Operation: {}.", m_description);
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+std::chrono::steady_clock::duration ic::operation::Operation::GetElapsed() const
+{
+    std::scoped_lock lock{ m_mutex };
+
+    if (m_finished)
+    {
+        return m_elapsed;
+    }
+
+    if (!m_started || m_startTime == std::chrono::steady_clock::time_point{})
+    {
+        return std::chrono::steady_clock::duration::zero();
+    }
+
+    const auto end{ m_paused ? m_pauseTime : std::chrono::steady_clock::now() };
+
+    return end - m_startTime - m_pausedDuration;
+}
+
+double ic::operation::Operation::GetBytesPerSecond() const
+{
+    const auto seconds{ std::chrono::duration<double>(GetElapsed()).count() };
+
+    return seconds > 0.0 ? static_cast<double>(m_progress.bytes.load()) / seconds : 0.0;
+}
+
+double ic::operation::Operation::GetFilesPerSecond() const
+{
+    const auto seconds{ std::chrono::duration<double>(GetElapsed()).count() };
+
+    return seconds > 0.0 ? static_cast<double>(m_progress.files.load()) / seconds : 0.0;
+}
+
+std::optional<std::chrono::seconds> ic::operation::Operation::GetRemaining() const
+{
+    if (m_finished)
+    {
+        return std::chrono::seconds::zero();
+    }
+
+    // the bytes are the better measure, if there are any
+    double remaining;
+    double rate;
+    if (const auto totalBytes{ m_progress.totalBytes.load() }; totalBytes > 0)
+    {
+        remaining = static_cast<double>(totalBytes - std::min(totalBytes, m_progress.bytes.load()));
+        rate = GetBytesPerSecond();
+    }
+    else if (const auto totalFiles{ m_progress.totalFiles.load() }; totalFiles > 0)
+    {
+        remaining = static_cast<double>(totalFiles - std::min(totalFiles, m_progress.files.load()));
+        rate = GetFilesPerSecond();
+    }
+    else
+    {
+        return std::nullopt;
+    }
+
+    if (rate <= 0.0)
+    {
+        return std::nullopt;
+    }
+
+    return std::chrono::seconds(static_cast<std::chrono::seconds::rep>(remaining / rate));
+}
+
+std::vector<std::string> ic::operation::Operation::GetErrors() const
+{
+    std::scoped_lock lock{ m_mutex };
+
+    return m_errors;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+bool ic::operation::Operation::Claim()
+{
+    return !m_stopSource.stop_requested() && !m_started.exchange(true);
+}
+
+void ic::operation::Operation::Execute()
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        m_startTime = std::chrono::steady_clock::now();
+
+        // an operation paused before it was started counts its pause from here
+        m_pauseTime = m_startTime;
+    }
+
+    Run(m_stopSource.get_token());
+
+    std::chrono::steady_clock::duration elapsed;
+    {
+        std::scoped_lock lock{ m_mutex };
+        elapsed = std::chrono::steady_clock::now() - m_startTime - m_pausedDuration;
+        m_elapsed = elapsed;
+    }
+
+    // logged before the operation is finished: from then on the UI thread may remove it
+    IC_LOG_DEBUG("[Operation::Execute()] {} {} after {} ms.",
+        m_description,
+        IsCancelled() ? "cancelled" : "finished",
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+
+    m_finished = true;
+}
+
+void ic::operation::Operation::Release()
+{
+    m_released = true;
+}
+
+void ic::operation::Operation::Cancel()
+{
+    m_stopSource.request_stop();
+
+    // nobody will execute it
+    if (!m_started.exchange(true))
+    {
+        m_finished = true;
+        m_released = true;
+    }
+
+    m_resumed.notify_all();
+}
+
+void ic::operation::Operation::Pause()
+{
+    std::scoped_lock lock{ m_mutex };
+    if (!m_paused && !m_finished)
+    {
+        m_pauseTime = std::chrono::steady_clock::now();
+        m_paused = true;
+    }
+}
+
+void ic::operation::Operation::Resume()
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        if (!m_paused)
+        {
+            return;
+        }
+
+        // a queued operation has no start time yet
+        if (m_startTime != std::chrono::steady_clock::time_point{})
+        {
+            m_pausedDuration += std::chrono::steady_clock::now() - m_pauseTime;
+        }
+        m_paused = false;
+    }
+
+    m_resumed.notify_all();
+}
+
+void ic::operation::Operation::TakeChanges(std::vector<Change>& t_changes)
+{
+    std::scoped_lock lock{ m_mutex };
+
+    std::ranges::move(m_changes, std::back_inserter(t_changes));
+    m_changes.clear();
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+bool ic::operation::Operation::Proceed(const std::stop_token& t_stopToken)
+{
+    if (m_paused)
+    {
+        std::unique_lock lock{ m_mutex };
+        m_resumed.wait(lock, t_stopToken, [this] { return !m_paused; });
+    }
+
+    return !t_stopToken.stop_requested();
+}
+
+void ic::operation::Operation::AddError(const std::filesystem::path& t_path, const std::string& t_message)
+{
+    IC_LOG_WARN("[Operation::AddError()] {}: {}", t_path.string(), t_message);
+
+    std::scoped_lock lock{ m_mutex };
+    m_errors.push_back(t_path.string().append(": ").append(t_message));
+}
+
+void ic::operation::Operation::AddError(const std::filesystem::path& t_path, const std::error_code& t_ec)
+{
+    AddError(t_path, t_ec.message());
+}
+
+void ic::operation::Operation::AddChange(const std::filesystem::path& t_path)
+{
+    std::scoped_lock lock{ m_mutex };
+    m_changes.push_back({ t_path.parent_path(), t_path.filename().string() });
+}
@@ -0,0 +1,239 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <cstdint>
+
+namespace ic::operation
+{
+    /**
+     * The progress of an operation; written by the worker, read by the UI.
+     */
+    struct Progress
+    {
+        std::atomic<std::uint64_t> bytes{ 0 };
+        std::atomic<std::uint64_t> totalBytes{ 0 };
+        std::atomic<std::uint64_t> files{ 0 };
+        std::atomic<std::uint64_t> totalFiles{ 0 };
+
+        /**
+         * The number of files worked on at the same time, if the operation chooses it; otherwise 0.
+         */
+        std::atomic<std::size_t> concurrency{ 0 };
+    };
+
+    /**
+     * An entry that was created or removed by an operation.
+     */
+    struct Change
+    {
+        std::filesystem::path directory;
+        std::string name;
+    };
+
+    /**
+     * The order in which queued operations are started.
+     */
+    enum class Priority
+    {
+        HIGH, NORMAL, LOW
+    };
+
+    /**
+     * A file operation that runs in the background.
+     * It is executed by a worker of the OperationQueue, which destroys
+     * it only after the worker has released it.
+     */
+    class Operation
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Operation() = delete;
+
+        /**
+         * @param t_verb Describes the operation to the user, e.g. "Copy".
+         * @param t_sources The files and directories to work on.
+         * @param t_target The target directory, if the operation has one.
+         * @param t_priority The initial priority.
+         */
+        Operation(std::string_view t_verb, std::vector<std::filesystem::path> t_sources, std::filesystem::path t_target, Priority t_priority);
+
+        Operation(const Operation& t_other) = delete;
+        Operation(Operation&& t_other) noexcept = delete;
+        Operation& operator=(const Operation& t_other) = delete;
+        Operation& operator=(Operation&& t_other) noexcept = delete;
+
+        virtual ~Operation() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] const std::string& GetDescription() const { return m_description; }
+        [[nodiscard]] const Progress& GetProgress() const { return m_progress; }
+        [[nodiscard]] Priority GetPriority() const { return m_priority; }
+        [[nodiscard]] bool IsStarted() const { return m_started; }
+        [[nodiscard]] bool IsFinished() const { return m_finished; }
+        [[nodiscard]] bool IsReleased() const { return m_released; }
+        [[nodiscard]] bool IsCancelled() const { return m_stopSource.stop_requested(); }
+        [[nodiscard]] bool IsPaused() const { return m_paused; }
+
+        /**
+         * @return The running time without pauses; stops when the operation has finished.
+         */
+        [[nodiscard]] std::chrono::steady_clock::duration GetElapsed() const;
+
+        [[nodiscard]] double GetBytesPerSecond() const;
+        [[nodiscard]] double GetFilesPerSecond() const;
+
+        /**
+         * Estimates the remaining time from the rate so far.
+         *
+         * @return The remaining time, or nothing if the total is unknown.
+         */
+        [[nodiscard]] std::optional<std::chrono::seconds> GetRemaining() const;
+
+        [[nodiscard]] std::vector<std::string> GetErrors() const;
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * Only changes the order while the operation is queued.
+         */
+        void SetPriority(Priority t_priority) { m_priority = t_priority; }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Marks the operation as started, unless it was started or cancelled before.
+         *
+         * @return True if the caller has to call Execute().
+         */
+        [[nodiscard]] bool Claim();
+
+        /**
+         * Runs the operation in the calling thread.
+         */
+        void Execute();
+
+        /**
+         * Is called by the worker when it no longer touches the operation,
+         * i.e. after Execute() has returned. Only then it may be destroyed.
+         */
+        void Release();
+
+        /**
+         * Requests the operation to stop. Does not wait for the worker.
+         * A queued operation is finished at once.
+         */
+        void Cancel();
+
+        /**
+         * Halts the operation at its next checkpoint.
+         */
+        void Pause();
+
+        void Resume();
+
+        /**
+         * Moves the changes made so far into the given vector.
+         *
+         * @param t_changes Receives the changes.
+         */
+        void TakeChanges(std::vector<Change>& t_changes);
+
+    protected:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        std::vector<std::filesystem::path> m_sources;
+        std::filesystem::path m_target;
+        Progress m_progress;
+
+        //-------------------------------------------------
+        // Run
+        //-------------------------------------------------
+
+        virtual void Run(const std::stop_token& t_stopToken) = 0;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * A checkpoint of the worker; blocks while the operation is paused.
+         *
+         * @param t_stopToken The token passed to Run().
+         *
+         * @return False if the operation should stop.
+         */
+        [[nodiscard]] bool Proceed(const std::stop_token& t_stopToken);
+
+        void AddError(const std::filesystem::path& t_path, const std::string& t_message);
+        void AddError(const std::filesystem::path& t_path, const std::error_code& t_ec);
+
+        /**
+         * Reports a created or removed entry, so that the views showing its directory can be updated.
+         *
+         * @param t_path The entry.
+         */
+        void AddChange(const std::filesystem::path& t_path);
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        std::string m_description;
+        std::atomic<Priority> m_priority;
+
+        std::stop_source m_stopSource;
+        std::atomic_bool m_started{ false };
+        std::atomic_bool m_finished{ false };
+        std::atomic_bool m_released{ false };
+        std::atomic_bool m_paused{ false };
+
+        mutable std::mutex m_mutex;
+        std::condition_variable_any m_resumed;
+        std::chrono::steady_clock::time_point m_startTime;
+        std::chrono::steady_clock::time_point m_pauseTime;
+        std::chrono::steady_clock::duration m_pausedDuration{ 0 };
+        std::chrono::steady_clock::duration m_elapsed{ 0 };
+        std::vector<std::string> m_errors;
+        std::vector<Change> m_changes;
+    };
+}
@@ -0,0 +1,195 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <algorithm>
+#include "OperationQueue.h"
+#include "Log.h"
+#include "application/Util.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::operation::OperationQueue::OperationQueue(const std::size_t t_workers)
+    : m_workerCount{ std::clamp<std::size_t>(t_workers, 1, MAX_WORKERS) }
+{
+    IC_LOG_DEBUG("[OperationQueue::OperationQueue()] Create OperationQueue with {} workers.", m_workerCount);
+
+    m_workers.reserve(m_workerCount);
+    for (std::size_t i{ 0 }; i < m_workerCount; ++i)
+    {
+        m_workers.emplace_back([this](const std::stop_token& t_stopToken) { Work(t_stopToken); });
+    }
+}
+
+ic::operation::OperationQueue::~OperationQueue() noexcept
+{
+    IC_LOG_DEBUG("[OperationQueue::~OperationQueue()] Destruct OperationQueue.");
+
+    for (const auto& operation : m_operations)
+    {
+        operation->Cancel();
+    }
+
+    // joins the workers, so no operation is used when the members are destroyed
+    m_workers.clear();
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::operation::OperationQueue::Add(std::unique_ptr<Operation> t_operation)
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        m_operations.push_back(std::move(t_operation));
+    }
+
+    m_condition.notify_one();
+}
+
+void ic::operation::OperationQueue::Remove(const Operation* t_operation)
+{
+    std::scoped_lock lock{ m_mutex };
+    std::erase_if(m_operations, [t_operation](const std::unique_ptr<Operation>& t_item) {
+        return t_item.get() == t_operation && t_item->IsReleased();
+    });
+}
+
+void ic::operation::OperationQueue::RemoveFinished()
+{
+    std::scoped_lock lock{ m_mutex };
+    std::erase_if(m_operations, [](const std::unique_ptr<Operation>& t_item) {
+        return t_item->IsReleased();
+    });
+}
+
+void ic::operation::OperationQueue::SetPriority(Operation* t_operation, const Priority t_priority)
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        t_operation->SetPriority(t_priority);
+    }
+
+    m_condition.notify_all();
+}
+
+void ic::operation::OperationQueue::Pause(Operation* t_operation)
+{
+    t_operation->Pause();
+}
+
+void ic::operation::OperationQueue::Resume(Operation* t_operation)
+{
+    {
+        std::scoped_lock lock{ m_mutex };
+        t_operation->Resume();
+    }
+
+    // a queued operation may be started now
+    m_condition.notify_all();
+}
+
+void ic::operation::OperationQueue::Cancel(Operation* t_operation)
+{
+    t_operation->Cancel();
+}
+
+void ic::operation::OperationQueue::TakeChanges(std::vector<Change>& t_changes)
+{
+    for (const auto& operation : m_operations)
+    {
+        operation->TakeChanges(t_changes);
+    }
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void ic::operation::OperationQueue::Work(const std::stop_token& t_stopToken)
+{
+    application::Util::LowerThreadPriority();
+
+    while (true)
+    {
+        Operation* operation{ nullptr };
+        bool low;
+        {
+            std::unique_lock lock{ m_mutex };
+            if (!m_condition.wait(lock, t_stopToken, [&] { return (operation = Next()) != nullptr; }))
+            {
+                return;
+            }
+
+            low = operation->GetPriority() == Priority::LOW;
+            if (low)
+            {
+                ++m_lowRunning;
+            }
+        }
+
+        operation->Execute();
+
+        {
+            // the operation may be removed from now on and is not touched again
+            std::scoped_lock lock{ m_mutex };
+            operation->Release();
+
+            if (low)
+            {
+                --m_lowRunning;
+            }
+        }
+
+        // another low priority operation may be started now
+        if (low)
+        {
+            m_condition.notify_all();
+        }
+    }
+}
+
+ic::operation::Operation* ic::operation::OperationQueue::Next()
+{
+    const auto lowAllowed{ m_workerCount == 1 || m_lowRunning < m_workerCount - 1 };
+
+    while (true)
+    {
+        Operation* next{ nullptr };
+        for (const auto& operation : m_operations)
+        {
+            if (operation->IsStarted() || operation->IsPaused() || (operation->GetPriority() == Priority::LOW && !lowAllowed))
+            {
+                continue;
+            }
+
+            if (!next || operation->GetPriority() < next->GetPriority())
+            {
+                next = operation.get();
+            }
+        }
+
+        // a cancelled operation is skipped
+        if (!next || next->Claim())
+        {
+            return next;
+        }
+    }
+}
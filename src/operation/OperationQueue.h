@@ -0,0 +1,142 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Operation.h"
+
+namespace ic::operation
+{
+    /**
+     * Owns the operations and runs them on a fixed pool of workers.
+     * Queued operations are started by priority, then in the order they were added.
+     * Low priority operations leave the last worker free, so that another operation can start at once.
+     * The workers run with a lower CPU and I/O priority than the UI and the directory listings.
+     * All functions must be called from the UI thread.
+     */
+    class OperationQueue
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::size_t MAX_WORKERS{ 8 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        OperationQueue() = delete;
+
+        /**
+         * @param t_workers The number of workers.
+         */
+        explicit OperationQueue(std::size_t t_workers);
+
+        OperationQueue(const OperationQueue& t_other) = delete;
+        OperationQueue(OperationQueue&& t_other) noexcept = delete;
+        OperationQueue& operator=(const OperationQueue& t_other) = delete;
+        OperationQueue& operator=(OperationQueue&& t_other) noexcept = delete;
+
+        ~OperationQueue() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] const std::vector<std::unique_ptr<Operation>>& GetOperations() const { return m_operations; }
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Queues an operation.
+         *
+         * @param t_operation The operation.
+         */
+        void Add(std::unique_ptr<Operation> t_operation);
+
+        /**
+         * Removes a finished operation once its worker has released it.
+         *
+         * @param t_operation The operation.
+         */
+        void Remove(const Operation* t_operation);
+
+        /**
+         * Removes all finished operations released by their workers.
+         */
+        void RemoveFinished();
+
+        void SetPriority(Operation* t_operation, Priority t_priority);
+        void Pause(Operation* t_operation);
+        void Resume(Operation* t_operation);
+        void Cancel(Operation* t_operation);
+
+        /**
+         * Moves the changes of all operations into the given vector.
+         *
+         * @param t_changes Receives the changes.
+         */
+        void TakeChanges(std::vector<Change>& t_changes);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * Changed by the UI thread only; the workers read it with the mutex locked.
+         */
+        std::vector<std::unique_ptr<Operation>> m_operations;
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_condition;
+
+        std::size_t m_workerCount{ 1 };
+
+        /**
+         * The running low priority operations.
+         */
+        std::size_t m_lowRunning{ 0 };
+
+        std::vector<std::jthread> m_workers;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void Work(const std::stop_token& t_stopToken);
+
+        /**
+         * Claims the next operation to run. The mutex must be locked.
+         *
+         * @return The operation, or nullptr if none can be started.
+         */
+        Operation* Next();
+    };
+}
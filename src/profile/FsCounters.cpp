@@ -0,0 +1,168 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "IcProfile.h"
+
+#ifdef IC_ENABLE_PROFILING
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include "Log.h"
+#include "vendor/magic/magic_enum.hpp"
+
+//-------------------------------------------------
+// Member
+//-------------------------------------------------
+
+std::array<ic::profile::FsCounters::Site, ic::profile::FsCounters::MAX_SITES> ic::profile::FsCounters::m_sites;
+std::atomic<std::size_t> ic::profile::FsCounters::m_siteCount{ 0 };
+std::mutex ic::profile::FsCounters::m_mutex;
+
+ic::profile::FsCounters::Clock::time_point ic::profile::FsCounters::m_secondStart{ Clock::now() };
+
+//-------------------------------------------------
+// Scope
+//-------------------------------------------------
+
+ic::profile::FsCounters::Scope::~Scope() noexcept
+{
+    const auto error{ errno };
+
+    auto& site{ m_sites[m_site] };
+    site.calls.fetch_add(1, std::memory_order_relaxed);
+    site.nanoseconds.fetch_add(
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count()),
+        std::memory_order_relaxed
+    );
+
+    errno = error;
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+std::vector<ic::profile::FsCounters::Stats> ic::profile::FsCounters::GetSites()
+{
+    const auto count{ m_siteCount.load(std::memory_order_acquire) };
+
+    std::vector<Stats> stats;
+    stats.reserve(count);
+
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        const auto& site{ m_sites[i] };
+        stats.push_back({
+            site.name,
+            site.call,
+            site.calls.load(std::memory_order_relaxed),
+            site.perFrame,
+            site.perSecond,
+            static_cast<double>(site.nanoseconds.load(std::memory_order_relaxed)) / 1'000'000.0
+        });
+    }
+
+    return stats;
+}
+
+std::vector<ic::profile::FsCounters::Stats> ic::profile::FsCounters::GetCalls()
+{
+    std::array<Stats, magic_enum::enum_count<FsCall>()> calls{};
+    for (const auto call : magic_enum::enum_values<FsCall>())
+    {
+        calls[magic_enum::enum_integer(call)].name = magic_enum::enum_name(call);
+        calls[magic_enum::enum_integer(call)].call = call;
+    }
+
+    for (const auto& site : GetSites())
+    {
+        auto& stats{ calls[magic_enum::enum_integer(site.call)] };
+        stats.total += site.total;
+        stats.perFrame += site.perFrame;
+        stats.perSecond += site.perSecond;
+        stats.milliseconds += site.milliseconds;
+    }
+
+    std::vector<Stats> used;
+    std::ranges::copy_if(calls, std::back_inserter(used), [](const Stats& t_stats) { return t_stats.total > 0; });
+
+    return used;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+ic::profile::FsCounters::SiteId ic::profile::FsCounters::Register(const FsCall t_call, const char* t_name)
+{
+    std::scoped_lock lock{ m_mutex };
+
+    const auto count{ m_siteCount.load(std::memory_order_relaxed) };
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        if (m_sites[i].call == t_call && std::string_view(m_sites[i].name) == t_name)
+        {
+            return static_cast<SiteId>(i);
+        }
+    }
+
+    if (count == MAX_SITES)
+    {
+        IC_LOG_WARN("[FsCounters::Register()] Too many call sites, {} is counted as {}.", t_name, m_sites[MAX_SITES - 1].name);
+        return static_cast<SiteId>(MAX_SITES - 1);
+    }
+
+    m_sites[count].name = t_name;
+    m_sites[count].call = t_call;
+
+    // the site is complete before the readers see it
+    m_siteCount.store(count + 1, std::memory_order_release);
+
+    return static_cast<SiteId>(count);
+}
+
+void ic::profile::FsCounters::EndFrame()
+{
+    const auto now{ Clock::now() };
+    const auto elapsed{ std::chrono::duration<double>(now - m_secondStart).count() };
+    const auto count{ m_siteCount.load(std::memory_order_acquire) };
+
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        auto& site{ m_sites[i] };
+        const auto calls{ site.calls.load(std::memory_order_relaxed) };
+
+        site.perFrame = calls - site.frameMark;
+        site.frameMark = calls;
+
+        // while idle no frame is rendered: the rate is computed over the whole gap
+        if (elapsed >= 1.0)
+        {
+            site.perSecond = static_cast<double>(calls - site.secondMark) / elapsed;
+            site.secondMark = calls;
+        }
+    }
+
+    if (elapsed >= 1.0)
+    {
+        m_secondStart = now;
+    }
+}
+
+#endif
@@ -0,0 +1,169 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace ic::profile
+{
+    //-------------------------------------------------
+    // Call types
+    //-------------------------------------------------
+
+    enum class FsCall
+    {
+        STAT,
+        LSTAT,
+        FSTATAT,
+        ACCESS,
+        READLINK,
+        OPEN,
+        GETDENTS,
+        READDIR,    // std::filesystem::directory_iterator
+        IO_URING,   // a batch of statx requests
+        INOTIFY
+    };
+
+    /**
+     * Counts the filesystem calls and their latency by call type and by call site.
+     * The calls are counted on any thread; the statistics are read on the UI thread.
+     * Use the IC_PROFILE_FS macro of IcProfile.h, so that the counting compiles out.
+     */
+    class FsCounters
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::size_t MAX_SITES{ 64 };
+
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        using Clock = std::chrono::steady_clock;
+        using SiteId = std::uint16_t;
+
+        struct Stats
+        {
+            std::string_view name;
+            FsCall call{ FsCall::STAT };
+            std::uint64_t total{ 0 };
+            std::uint64_t perFrame{ 0 };
+            double perSecond{ 0.0 };
+            double milliseconds{ 0.0 };
+        };
+
+        /**
+         * Measures a call. errno is kept for the caller.
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(const SiteId t_site)
+                : m_site{ t_site }
+                , m_start{ Clock::now() }
+            {}
+
+            Scope(const Scope& t_other) = delete;
+            Scope(Scope&& t_other) noexcept = delete;
+            Scope& operator=(const Scope& t_other) = delete;
+            Scope& operator=(Scope&& t_other) noexcept = delete;
+
+            ~Scope() noexcept;
+
+        private:
+            SiteId m_site;
+            Clock::time_point m_start;
+        };
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @return The statistics of each call site.
+         */
+        [[nodiscard]] static std::vector<Stats> GetSites();
+
+        /**
+         * @return The statistics of each call type that was used.
+         */
+        [[nodiscard]] static std::vector<Stats> GetCalls();
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Adds a call site. Is called once per instrumented call.
+         * Calls of the same type with the same site name are counted together.
+         *
+         * @param t_call The call type.
+         * @param t_name A string literal, e.g. "InfoWidget::Render".
+         *
+         * @return The id of the call site.
+         */
+        static SiteId Register(FsCall t_call, const char* t_name);
+
+        /**
+         * Closes the counts of a rendered frame. Must be called from the UI thread.
+         */
+        static void EndFrame();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Site
+        {
+            const char* name{ nullptr };
+            FsCall call{ FsCall::STAT };
+
+            std::atomic<std::uint64_t> calls{ 0 };
+            std::atomic<std::uint64_t> nanoseconds{ 0 };
+
+            // UI thread only
+            std::uint64_t frameMark{ 0 };
+            std::uint64_t perFrame{ 0 };
+            std::uint64_t secondMark{ 0 };
+            double perSecond{ 0.0 };
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        static std::array<Site, MAX_SITES> m_sites;
+        static std::atomic<std::size_t> m_siteCount;
+        static std::mutex m_mutex;
+
+        static Clock::time_point m_secondStart;
+    };
+}
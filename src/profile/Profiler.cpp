@@ -0,0 +1,214 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "IcProfile.h"
+
+#ifdef IC_ENABLE_PROFILING
+
+#include <algorithm>
+#include <fstream>
+#include "Log.h"
+
+//-------------------------------------------------
+// Member
+//-------------------------------------------------
+
+std::array<ic::profile::Profiler::Phase, ic::profile::Profiler::MAX_PHASES> ic::profile::Profiler::m_phases{ Phase{ "Frame" } };
+std::size_t ic::profile::Profiler::m_phaseCount{ 1 };
+
+std::array<ic::profile::Profiler::Sample, ic::profile::Profiler::CAPACITY> ic::profile::Profiler::m_samples;
+std::size_t ic::profile::Profiler::m_sampleCount{ 0 };
+
+std::size_t ic::profile::Profiler::m_frameCount{ 0 };
+ic::profile::Profiler::Clock::time_point ic::profile::Profiler::m_frameStart;
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+std::vector<ic::profile::Profiler::Stats> ic::profile::Profiler::GetStats()
+{
+    std::vector<Stats> stats;
+    stats.reserve(m_phaseCount);
+
+    for (std::size_t i{ 0 }; i < m_phaseCount; ++i)
+    {
+        stats.push_back(ComputeStats(m_phases[i]));
+    }
+
+    return stats;
+}
+
+std::vector<float> ic::profile::Profiler::GetFrameTimes()
+{
+    const auto& times{ m_phases[FRAME_PHASE].times };
+    const auto count{ std::min(m_frameCount, FRAMES) };
+
+    // the oldest frame is overwritten next
+    std::vector<float> frameTimes;
+    frameTimes.reserve(count);
+    for (auto i{ m_frameCount - count }; i < m_frameCount; ++i)
+    {
+        frameTimes.push_back(times[i % FRAMES]);
+    }
+
+    return frameTimes;
+}
+
+ic::profile::Profiler::Histogram ic::profile::Profiler::GetHistogram()
+{
+    Histogram histogram{};
+    for (const auto time : GetFrameTimes())
+    {
+        const auto bucket{ std::ranges::lower_bound(BUCKETS, time) };
+        ++histogram[static_cast<std::size_t>(bucket - BUCKETS.begin())];
+    }
+
+    return histogram;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+ic::profile::Profiler::PhaseId ic::profile::Profiler::Register(const char* t_name)
+{
+    if (m_phaseCount == MAX_PHASES)
+    {
+        IC_LOG_WARN("[Profiler::Register()] Too many phases, {} is measured as {}.", t_name, m_phases[MAX_PHASES - 1].name);
+        return static_cast<PhaseId>(MAX_PHASES - 1);
+    }
+
+    m_phases[m_phaseCount].name = t_name;
+
+    return static_cast<PhaseId>(m_phaseCount++);
+}
+
+void ic::profile::Profiler::Record(const PhaseId t_phase, const Clock::time_point t_start, const Clock::time_point t_end)
+{
+    auto& phase{ m_phases[t_phase] };
+    phase.frameTotal += t_end - t_start;
+    ++phase.frameCalls;
+
+    m_samples[m_sampleCount++ % CAPACITY] = { t_phase, t_start, t_end - t_start };
+}
+
+void ic::profile::Profiler::BeginFrame()
+{
+    m_frameStart = Clock::now();
+}
+
+void ic::profile::Profiler::EndFrame(const bool t_rendered)
+{
+    if (t_rendered)
+    {
+        Record(FRAME_PHASE, m_frameStart, Clock::now());
+    }
+
+    const auto slot{ m_frameCount % FRAMES };
+    for (std::size_t i{ 0 }; i < m_phaseCount; ++i)
+    {
+        auto& phase{ m_phases[i] };
+        if (t_rendered)
+        {
+            phase.times[slot] = ToMilliseconds(phase.frameTotal);
+            phase.calls[slot] = phase.frameCalls;
+        }
+
+        phase.frameTotal = Clock::duration::zero();
+        phase.frameCalls = 0;
+    }
+
+    if (t_rendered)
+    {
+        ++m_frameCount;
+        FsCounters::EndFrame();
+    }
+}
+
+bool ic::profile::Profiler::WriteTrace(const std::filesystem::path& t_path)
+{
+    std::ofstream file{ t_path, std::ios::trunc };
+    if (!file)
+    {
+        IC_LOG_ERROR("[Profiler::WriteTrace()] Unable to open {}.", t_path.string());
+        return false;
+    }
+
+    const auto count{ std::min(m_sampleCount, CAPACITY) };
+    const auto epoch{ m_samples[(m_sampleCount - count) % CAPACITY].start };
+
+    // complete events with the times in microseconds; the phase names are string literals without quotes
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (auto i{ m_sampleCount - count }; i < m_sampleCount; ++i)
+    {
+        const auto& sample{ m_samples[i % CAPACITY] };
+        file << (i == m_sampleCount - count ? "\n" : ",\n")
+             << R"({"name":")" << m_phases[sample.phase].name
+             << R"(","ph":"X","pid":1,"tid":1,"ts":)" << std::chrono::duration<double, std::micro>(sample.start - epoch).count()
+             << R"(,"dur":)" << std::chrono::duration<double, std::micro>(sample.duration).count() << "}";
+    }
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        IC_LOG_ERROR("[Profiler::WriteTrace()] Unable to write {}.", t_path.string());
+        return false;
+    }
+
+    IC_LOG_INFO("[Profiler::WriteTrace()] {} samples written to {}.", count, t_path.string());
+
+    return true;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+ic::profile::Profiler::Stats ic::profile::Profiler::ComputeStats(const Phase& t_phase)
+{
+    Stats stats;
+    stats.name = t_phase.name;
+
+    const auto count{ std::min(m_frameCount, FRAMES) };
+    if (count == 0)
+    {
+        return stats;
+    }
+
+    const auto last{ (m_frameCount - 1) % FRAMES };
+    stats.last = t_phase.times[last];
+    stats.calls = t_phase.calls[last];
+
+    auto sum{ 0.0f };
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        sum += t_phase.times[i];
+        stats.max = std::max(stats.max, t_phase.times[i]);
+    }
+    stats.average = sum / static_cast<float>(count);
+
+    return stats;
+}
+
+float ic::profile::Profiler::ToMilliseconds(const Clock::duration t_duration)
+{
+    return std::chrono::duration<float, std::milli>(t_duration).count();
+}
+
+#endif
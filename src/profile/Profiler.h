@@ -0,0 +1,207 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace ic::profile
+{
+    /**
+     * Records the durations of the instrumented scopes of the UI thread in a ring buffer.
+     * Use the macros of IcProfile.h, so that the instrumentation compiles out.
+     */
+    class Profiler
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The number of samples kept for a trace.
+         */
+        static constexpr std::size_t CAPACITY{ 1 << 16 };
+
+        /**
+         * The number of rendered frames the statistics are computed from.
+         */
+        static constexpr std::size_t FRAMES{ 240 };
+
+        static constexpr std::size_t MAX_PHASES{ 64 };
+
+        /**
+         * The first phase measures the whole frame.
+         */
+        static constexpr std::uint16_t FRAME_PHASE{ 0 };
+
+        /**
+         * The upper limits of the frame time histogram in milliseconds.
+         * The last bucket holds the slower frames.
+         */
+        static constexpr std::array<float, 5> BUCKETS{ 4.0f, 8.0f, 16.7f, 33.3f, 66.7f };
+
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        using Clock = std::chrono::steady_clock;
+        using PhaseId = std::uint16_t;
+        using Histogram = std::array<std::size_t, BUCKETS.size() + 1>;
+
+        /**
+         * The time a phase took in the last FRAMES rendered frames in milliseconds.
+         */
+        struct Stats
+        {
+            const char* name{ nullptr };
+            float last{ 0.0f };
+            float average{ 0.0f };
+            float max{ 0.0f };
+            std::uint32_t calls{ 0 };
+        };
+
+        /**
+         * Measures the lifetime of a scope.
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(const PhaseId t_phase)
+                : m_phase{ t_phase }
+                , m_start{ Clock::now() }
+            {}
+
+            Scope(const Scope& t_other) = delete;
+            Scope(Scope&& t_other) noexcept = delete;
+            Scope& operator=(const Scope& t_other) = delete;
+            Scope& operator=(Scope&& t_other) noexcept = delete;
+
+            ~Scope() noexcept
+            {
+                Record(m_phase, m_start, Clock::now());
+            }
+
+        private:
+            PhaseId m_phase;
+            Clock::time_point m_start;
+        };
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @return The statistics of the frames, followed by those of the other phases.
+         */
+        [[nodiscard]] static std::vector<Stats> GetStats();
+
+        /**
+         * @return The times of the last FRAMES rendered frames, the oldest first.
+         */
+        [[nodiscard]] static std::vector<float> GetFrameTimes();
+
+        [[nodiscard]] static Histogram GetHistogram();
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Adds a phase. Is called once per instrumented scope.
+         *
+         * @param t_name A string literal, e.g. "View::Update".
+         *
+         * @return The id of the phase.
+         */
+        static PhaseId Register(const char* t_name);
+
+        static void Record(PhaseId t_phase, Clock::time_point t_start, Clock::time_point t_end);
+
+        /**
+         * Starts a frame when the application loop wakes up.
+         */
+        static void BeginFrame();
+
+        /**
+         * Ends a frame. Only rendered frames count for the statistics,
+         * but the samples of the other loop iterations are kept for the trace.
+         *
+         * @param t_rendered True if the frame was rendered.
+         */
+        static void EndFrame(bool t_rendered);
+
+        /**
+         * Writes the samples in the ring buffer in the Chrome trace event format,
+         * which can be opened with chrome://tracing or Perfetto.
+         *
+         * @param t_path The file to write.
+         *
+         * @return True on success.
+         */
+        static bool WriteTrace(const std::filesystem::path& t_path);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Phase
+        {
+            const char* name{ nullptr };
+            std::array<float, FRAMES> times{};
+            std::array<std::uint32_t, FRAMES> calls{};
+
+            Clock::duration frameTotal{ Clock::duration::zero() };
+            std::uint32_t frameCalls{ 0 };
+        };
+
+        struct Sample
+        {
+            PhaseId phase{ 0 };
+            Clock::time_point start;
+            Clock::duration duration{ Clock::duration::zero() };
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        static std::array<Phase, MAX_PHASES> m_phases;
+        static std::size_t m_phaseCount;
+
+        static std::array<Sample, CAPACITY> m_samples;
+        static std::size_t m_sampleCount;
+
+        static std::size_t m_frameCount;
+        static Clock::time_point m_frameStart;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        [[nodiscard]] static Stats ComputeStats(const Phase& t_phase);
+        [[nodiscard]] static float ToMilliseconds(Clock::duration t_duration);
+    };
+}
@@ -22,18 +22,29 @@
 #include "BottomMenuWidget.h"
 #include "IcAssert.h"
 #include "application/Application.h"
+#include "operation/OperationQueue.h"
+#include "operation/CopyOperation.h"
+#include "operation/MoveOperation.h"
+#include "operation/DeleteOperation.h"
+#include "async/FileSystem.h"
 #include "vendor/imgui/imgui_stdlib.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
 //-------------------------------------------------
 
-ic::widget::BottomMenuWidget::BottomMenuWidget(data::View* t_parentLeftView, data::View* t_parentRightView)
+ic::widget::BottomMenuWidget::BottomMenuWidget(
+    data::View* t_parentLeftView,
+    data::View* t_parentRightView,
+    operation::OperationQueue* t_operationQueue
+)
     : m_parentLeftView{ t_parentLeftView }
     , m_parentRightView{ t_parentRightView }
+    , m_operationQueue{ t_operationQueue }
 {
     IC_ASSERT(m_parentLeftView, "[BottomMenuWidget::BottomMenuWidget()] Null pointer.")
     IC_ASSERT(m_parentRightView, "[BottomMenuWidget::BottomMenuWidget()] Null pointer.")
+    IC_ASSERT(m_operationQueue, "[BottomMenuWidget::BottomMenuWidget()] Null pointer.")
 
     IC_LOG_DEBUG("[BottomMenuWidget::BottomMenuWidget()] Create BottomMenuWidget.");
 }
@@ -96,6 +107,12 @@ void ic::widget::BottomMenuWidget::Render()
     }
     ImGui::SameLine();
 
+    if (ImGui::Button("Jobs##bottomJobs"))
+    {
+        application::Application::show_jobs = !application::Application::show_jobs;
+    }
+    ImGui::SameLine();
+
     ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
     if (ImGui::Button("Menu##bottomMenu")) {}
     ImGui::SameLine();
@@ -103,11 +120,21 @@ void ic::widget::BottomMenuWidget::Render()
     ImGui::SameLine();
     if (ImGui::Button("Edit##bottomEdit")) {}
     ImGui::SameLine();
-    if (ImGui::Button("Copy##bottomCopy")) {}
+    ImGui::PopItemFlag();
+
+    if (ImGui::Button("Copy##bottomCopy") && CollectSources())
+    {
+        ImGui::OpenPopup("##bottomModalCopy");
+    }
+    RenderTransferModal("##bottomModalCopy", false);
     ImGui::SameLine();
-    if (ImGui::Button("Move##bottomMove")) {}
+
+    if (ImGui::Button("Move##bottomMove") && CollectSources())
+    {
+        ImGui::OpenPopup("##bottomModalMove");
+    }
+    RenderTransferModal("##bottomModalMove", true);
     ImGui::SameLine();
-    ImGui::PopItemFlag();
 
     if (ImGui::Button("MkDir##bottomMkDir"))
     {
@@ -129,8 +156,6 @@ void ic::widget::BottomMenuWidget::Render()
         ImGui::SameLine();
         if(ImGui::Button("Create##bottomModalMkDirCreate"))
         {
-            // todo: event
-
             std::filesystem::path p;
             if (application::Application::current_view_type == data::ViewType::LEFT)
             {
@@ -141,33 +166,8 @@ void ic::widget::BottomMenuWidget::Render()
                 p = m_parentRightView->currentPath / newPathStr;
             }
 
-            if (!std::filesystem::exists(p))
-            {
-                if (std::filesystem::create_directory(p))
-                {
-                    IC_LOG_DEBUG("[BottomMenuWidget::Render()] Directory {} created successfully.", p.filename().string());
-
-                    application::Application::event_dispatcher.dispatch(
-                        event::IcEventType::DIRTY,
-                        event::DirtyEvent(m_parentLeftView->currentPath, data::ViewType::LEFT)
-                    );
-
-                    application::Application::event_dispatcher.dispatch(
-                        event::IcEventType::DIRTY,
-                        event::DirtyEvent(m_parentRightView->currentPath, data::ViewType::RIGHT)
-                    );
-
-                    newPathStr.clear();
-                }
-                else
-                {
-                    IC_LOG_WARN("[BottomMenuWidget::Render()] Failed to create directory {}.", p.filename().string());
-                }
-            }
-            else
-            {
-                IC_LOG_WARN("[BottomMenuWidget::Render()] Directory {} already exists.", p.filename().string());
-            }
+            async::Spawn(MakeDirectory(std::move(p)));
+            newPathStr.clear();
 
             ImGui::CloseCurrentPopup();
         }
@@ -177,9 +177,14 @@ void ic::widget::BottomMenuWidget::Render()
     }
     ImGui::SameLine();
 
-    ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
-    if (ImGui::Button("Delete##bottomDelete")) {}
+    if (ImGui::Button("Delete##bottomDelete") && CollectSources())
+    {
+        ImGui::OpenPopup("##bottomModalDelete");
+    }
+    RenderDeleteModal();
     ImGui::SameLine();
+
+    ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
     if (ImGui::Button("PullDn##bottomPullDn")) {}
     ImGui::SameLine();
     ImGui::PopItemFlag();
@@ -193,3 +198,145 @@ void ic::widget::BottomMenuWidget::Render()
 
     ImGui::End();
 }
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+bool ic::widget::BottomMenuWidget::CollectSources()
+{
+    m_sources.clear();
+
+    const data::View* activeView;
+    const data::View* otherView;
+    if (application::Application::current_view_type == data::ViewType::LEFT)
+    {
+        activeView = m_parentLeftView;
+        otherView = m_parentRightView;
+    }
+    else if (application::Application::current_view_type == data::ViewType::RIGHT)
+    {
+        activeView = m_parentRightView;
+        otherView = m_parentLeftView;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (!activeView->selectedEntries.empty())
+    {
+        m_sources.assign(activeView->selectedEntries.begin(), activeView->selectedEntries.end());
+    }
+    else if (!activeView->currentSelectedPath.empty())
+    {
+        m_sources.push_back(activeView->currentSelectedPath);
+    }
+
+    m_target = otherView->currentPath;
+
+    return !m_sources.empty();
+}
+
+void ic::widget::BottomMenuWidget::RenderTransferModal(const char* t_id, const bool t_move)
+{
+    if (ImGui::BeginPopupModal(t_id, nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        const auto* verb{ t_move ? "Move" : "Copy" };
+        if (m_sources.size() == 1)
+        {
+            ImGui::Text("%s %s", verb, m_sources.front().filename().string().c_str());
+        }
+        else
+        {
+            ImGui::Text("%s %zu entries", verb, m_sources.size());
+        }
+        ImGui::Text("to %s?", m_target.string().c_str());
+
+        ImGui::PushID(t_id);
+        if (ImGui::Button("Close##bottomModalTransferClose", ImVec2(120, 0)))
+        {
+            m_sources.clear();
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button(verb, ImVec2(120, 0)))
+        {
+            if (t_move)
+            {
+                m_operationQueue->Add(std::make_unique<operation::MoveOperation>(std::move(m_sources), m_target));
+            }
+            else
+            {
+                m_operationQueue->Add(std::make_unique<operation::CopyOperation>(std::move(m_sources), m_target));
+            }
+            application::Application::show_jobs = true;
+
+            m_sources.clear();
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::PopID();
+
+        ImGui::SetItemDefaultFocus();
+        ImGui::EndPopup();
+    }
+}
+
+void ic::widget::BottomMenuWidget::RenderDeleteModal()
+{
+    if (ImGui::BeginPopupModal("##bottomModalDelete", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        if (m_sources.size() == 1)
+        {
+            ImGui::Text("Delete %s?", m_sources.front().filename().string().c_str());
+        }
+        else
+        {
+            ImGui::Text("Delete %zu entries?", m_sources.size());
+        }
+        ImGui::TextUnformatted("Directories are deleted with all their content.");
+
+        if (ImGui::Button("Close##bottomModalDeleteClose", ImVec2(120, 0)))
+        {
+            m_sources.clear();
+            ImGui::CloseCurrentPopup();
+        }
+
+        // the safe choice is the default
+        ImGui::SetItemDefaultFocus();
+
+        ImGui::SameLine();
+        if (ImGui::Button("Delete##bottomModalDeleteStart", ImVec2(120, 0)))
+        {
+            m_operationQueue->Add(std::make_unique<operation::DeleteOperation>(std::move(m_sources)));
+            application::Application::show_jobs = true;
+            m_sources.clear();
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::EndPopup();
+    }
+}
+
+ic::async::Task<> ic::widget::BottomMenuWidget::MakeDirectory(const std::filesystem::path t_path) const
+{
+    if (const auto ec{ co_await async::MakeDirectory(t_path) })
+    {
+        IC_LOG_WARN("[BottomMenuWidget::MakeDirectory()] Failed to create directory {}: {}", t_path.filename().string(), ec.message());
+        co_return;
+    }
+
+    IC_LOG_DEBUG("[BottomMenuWidget::MakeDirectory()] Directory {} created successfully.", t_path.filename().string());
+
+    // watched views are updated automatically
+    if (!m_parentLeftView->IsWatching())
+    {
+        application::Application::event_bus.Publish(event::DirtyEvent(m_parentLeftView->currentPath, data::ViewType::LEFT));
+    }
+
+    if (!m_parentRightView->IsWatching())
+    {
+        application::Application::event_bus.Publish(event::DirtyEvent(m_parentRightView->currentPath, data::ViewType::RIGHT));
+    }
+}
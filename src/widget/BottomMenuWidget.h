@@ -18,11 +18,20 @@
 
 #pragma once
 
+#include <vector>
+#include <filesystem>
+#include "async/Task.h"
+
 namespace ic::data
 {
     class View;
 }
 
+namespace ic::operation
+{
+    class OperationQueue;
+}
+
 namespace ic::widget
 {
     class BottomMenuWidget
@@ -34,7 +43,7 @@ namespace ic::widget
 
         BottomMenuWidget() = delete;
 
-        explicit BottomMenuWidget(data::View* t_parentLeftView, data::View* t_parentRightView);
+        BottomMenuWidget(data::View* t_parentLeftView, data::View* t_parentRightView, operation::OperationQueue* t_operationQueue);
 
         BottomMenuWidget(const BottomMenuWidget& t_other) = delete;
         BottomMenuWidget(BottomMenuWidget&& t_other) noexcept = delete;
@@ -65,10 +74,50 @@ namespace ic::widget
 
         data::View* m_parentLeftView{ nullptr };
         data::View* m_parentRightView{ nullptr };
+        operation::OperationQueue* m_operationQueue{ nullptr };
+
+        /**
+         * The entries to copy, move or delete, collected when the dialog opens.
+         */
+        std::vector<std::filesystem::path> m_sources;
+
+        /**
+         * The directory to copy or move into.
+         */
+        std::filesystem::path m_target;
 
         float m_pos_x{ -1.0f };
         float m_pos_y{ -1.0f };
         float m_size_x{ -1.0f };
         float m_size_y{ -1.0f };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Collects the selected entries of the active view
+         * and the currentPath of the other view as target.
+         *
+         * @return False if there is nothing to copy, move or delete.
+         */
+        bool CollectSources();
+
+        /**
+         * Asks whether to copy or move the collected sources.
+         *
+         * @param t_id The id of the popup.
+         * @param t_move True to move, false to copy.
+         */
+        void RenderTransferModal(const char* t_id, bool t_move);
+
+        void RenderDeleteModal();
+
+        /**
+         * Creates a directory without blocking the frame; continues on the UI thread.
+         *
+         * @param t_path The new directory.
+         */
+        async::Task<> MakeDirectory(std::filesystem::path t_path) const;
     };
 }
@@ -18,7 +18,9 @@
 
 #include <imgui.h>
 #include "DebugWidget.h"
+#include "IcProfile.h"
 #include "application/Application.h"
+#include "application/FramePacer.h"
 #include "vendor/magic/magic_enum.hpp"
 
 //-------------------------------------------------
@@ -36,7 +38,21 @@ void ic::widget::DebugWidget::Render(const application::Application* t_applicati
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0/fps, fps);
     ImGui::PopStyleColor(1);
 
+    // Frames
+
+    const auto& pacer{ t_application->GetFramePacer() };
+    const auto& frames{ pacer.GetStats() };
+    ImGui::Text("State: %s", std::string(magic_enum::enum_name(pacer.GetState())).c_str());
+    ImGui::Text("Frames: %zu active, %zu busy, %zu idle wake-ups", frames.activeFrames, frames.busyFrames, frames.idleWakeUps);
+
+    ImGui::Separator();
+
+#ifdef IC_ENABLE_PROFILING
+    RenderProfiler();
+    RenderFsCounters();
+
     ImGui::Separator();
+#endif
 
     // Current view type
 
@@ -46,6 +62,14 @@ void ic::widget::DebugWidget::Render(const application::Application* t_applicati
 
     ImGui::Separator();
 
+    // Listing cache
+
+    const auto stats{ application::Application::listing_cache.GetStats() };
+    ImGui::Text("Listing cache: %zu hits, %zu misses", stats.hits, stats.misses);
+    ImGui::Text("%zu listings, %.1f of %.1f MiB", stats.listings, static_cast<double>(stats.bytes) / 1048576.0, static_cast<double>(stats.budget) / 1048576.0);
+
+    ImGui::Separator();
+
     // Left selected
 
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 1.0f, 0.0f, 1.0f)); // yellow
@@ -70,3 +94,140 @@ void ic::widget::DebugWidget::Render(const application::Application* t_applicati
 
     ImGui::End();
 }
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+#ifdef IC_ENABLE_PROFILING
+void ic::widget::DebugWidget::RenderProfiler()
+{
+    if (!ImGui::TreeNode("Profiler"))
+    {
+        return;
+    }
+
+    if (ImGui::Button("Save trace"))
+    {
+        profile::Profiler::WriteTrace(TRACE_FILE);
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("%s", TRACE_FILE);
+
+    // per-phase timings in ms
+
+    if (ImGui::BeginTable("##profilerPhases", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Phase");
+        ImGui::TableSetupColumn("Last");
+        ImGui::TableSetupColumn("Avg.");
+        ImGui::TableSetupColumn("Max.");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableHeadersRow();
+
+        for (const auto& stats : profile::Profiler::GetStats())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(stats.name);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.3f", static_cast<double>(stats.last));
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.3f", static_cast<double>(stats.average));
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%.3f", static_cast<double>(stats.max));
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%u", stats.calls);
+        }
+
+        ImGui::EndTable();
+    }
+
+    // frame times
+
+    const auto frameTimes{ profile::Profiler::GetFrameTimes() };
+    ImGui::PlotLines("##profilerFrames", frameTimes.data(), static_cast<int>(frameTimes.size()), 0, "Frame time", 0.0f, 33.3f, ImVec2(0.0f, 60.0f));
+
+    const auto histogram{ profile::Profiler::GetHistogram() };
+    std::array<float, std::tuple_size_v<profile::Profiler::Histogram>> counts{};
+    std::ranges::transform(histogram, counts.begin(), [](const auto t_count) { return static_cast<float>(t_count); });
+    ImGui::PlotHistogram("##profilerHistogram", counts.data(), static_cast<int>(counts.size()), 0, "Frames", 0.0f, static_cast<float>(profile::Profiler::FRAMES), ImVec2(0.0f, 60.0f));
+
+    for (std::size_t i{ 0 }; i < histogram.size(); ++i)
+    {
+        if (i < profile::Profiler::BUCKETS.size())
+        {
+            ImGui::Text("< %5.1f ms: %zu", static_cast<double>(profile::Profiler::BUCKETS[i]), histogram[i]);
+        }
+        else
+        {
+            ImGui::Text(">= %4.1f ms: %zu", static_cast<double>(profile::Profiler::BUCKETS.back()), histogram[i]);
+        }
+    }
+
+    ImGui::TreePop();
+}
+
+void ic::widget::DebugWidget::RenderFsCounters()
+{
+    if (!ImGui::TreeNode("Filesystem calls"))
+    {
+        return;
+    }
+
+    const auto renderTable{ [](const char* t_id, const char* t_header, const std::vector<profile::FsCounters::Stats>& t_stats, const bool t_showCall) {
+        if (!ImGui::BeginTable(t_id, t_showCall ? 6 : 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            return;
+        }
+
+        ImGui::TableSetupColumn(t_header);
+        if (t_showCall)
+        {
+            ImGui::TableSetupColumn("Call");
+        }
+        ImGui::TableSetupColumn("Frame");
+        ImGui::TableSetupColumn("Per s");
+        ImGui::TableSetupColumn("Total");
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableHeadersRow();
+
+        for (const auto& stats : t_stats)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(stats.name.data(), stats.name.data() + stats.name.size());
+            if (t_showCall)
+            {
+                const auto call{ magic_enum::enum_name(stats.call) };
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(call.data(), call.data() + call.size());
+            }
+
+            // calls on the render path show up in every frame
+            ImGui::TableNextColumn();
+            if (stats.perFrame > 0)
+            {
+                ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "%llu", static_cast<unsigned long long>(stats.perFrame)); // orange
+            }
+            else
+            {
+                ImGui::TextUnformatted("0");
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", stats.perSecond);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.total));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.milliseconds);
+        }
+
+        ImGui::EndTable();
+    } };
+
+    renderTable("##fsCalls", "Call type", profile::FsCounters::GetCalls(), false);
+    renderTable("##fsSites", "Call site", profile::FsCounters::GetSites(), true);
+
+    ImGui::TreePop();
+}
+#endif
@@ -50,6 +50,24 @@ namespace ic::widget
     protected:
 
     private:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr const char* TRACE_FILE{ "ic_trace.json" };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Renders the phase timings and the frame time histogram of the Profiler.
+         */
+        static void RenderProfiler();
 
+        /**
+         * Renders the filesystem calls by call type and by call site.
+         */
+        static void RenderFsCounters();
     };
 }
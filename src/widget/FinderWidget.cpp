@@ -0,0 +1,237 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <imgui.h>
+#include <algorithm>
+#include "FinderWidget.h"
+#include "IcAssert.h"
+#include "IcProfile.h"
+#include "application/Application.h"
+#include "vendor/imgui/imgui_stdlib.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::widget::FinderWidget::FinderWidget(data::View* t_parentLeftView, data::View* t_parentRightView)
+    : m_parentLeftView{ t_parentLeftView }
+    , m_parentRightView{ t_parentRightView }
+    , m_index{ std::make_unique<data::FileIndex>() }
+{
+    IC_ASSERT(m_parentLeftView, "[FinderWidget::FinderWidget()] Null pointer.")
+    IC_ASSERT(m_parentRightView, "[FinderWidget::FinderWidget()] Null pointer.")
+
+    IC_LOG_DEBUG("[FinderWidget::FinderWidget()] Create FinderWidget.");
+}
+
+ic::widget::FinderWidget::~FinderWidget() noexcept
+{
+    IC_LOG_DEBUG("[FinderWidget::~FinderWidget()] Destruct FinderWidget.");
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool ic::widget::FinderWidget::IsIndexing() const
+{
+    return m_open && m_index->IsRunning();
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::widget::FinderWidget::Render() const
+{
+    auto& showFinder{ application::Application::show_finder };
+    if (ImGui::GetIO().KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_P, false))
+    {
+        showFinder = true;
+    }
+
+    if (showFinder)
+    {
+        showFinder = false;
+        Open();
+        ImGui::OpenPopup("Find file##finder");
+    }
+
+    ImGui::SetNextWindowSize({ 640.0f, 420.0f }, ImGuiCond_Appearing);
+    m_open = ImGui::BeginPopupModal("Find file##finder", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    if (!m_open)
+    {
+        return;
+    }
+
+    if (ImGui::RadioButton("Root##finderRoot", !m_currentDirectory))
+    {
+        m_currentDirectory = false;
+        Open();
+    }
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Current directory##finderCurrentDirectory", m_currentDirectory))
+    {
+        m_currentDirectory = true;
+        Open();
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("%s: %zu paths%s", m_index->GetRoot().string().c_str(), m_index->GetSize(), m_index->IsRunning() ? ", indexing ..." : "");
+
+    if (ImGui::IsWindowAppearing())
+    {
+        ImGui::SetKeyboardFocusHere();
+    }
+
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    if (ImGui::InputTextWithHint("##finderQuery", "Type to search", &m_query))
+    {
+        m_selected = 0;
+        Search();
+    }
+    else if (m_index->GetSize() != m_searchedSize && std::chrono::steady_clock::now() - m_searchTime >= UPDATE_INTERVAL)
+    {
+        // paths were added while the index is built or refreshed
+        Search();
+    }
+
+    if (!m_results.empty())
+    {
+        if (ImGui::IsKeyPressed(ImGuiKey_DownArrow))
+        {
+            m_selected = std::min(m_selected + 1, m_results.size() - 1);
+        }
+        if (ImGui::IsKeyPressed(ImGuiKey_UpArrow) && m_selected > 0)
+        {
+            --m_selected;
+        }
+    }
+
+    RenderResults();
+
+    if (ImGui::IsKeyPressed(ImGuiKey_Enter, false) && m_selected < m_results.size())
+    {
+        Select(m_results[m_selected]);
+    }
+
+    if (ImGui::Button("Close##finderClose", ImVec2(120, 0)) || ImGui::IsKeyPressed(ImGuiKey_Escape, false))
+    {
+        ImGui::CloseCurrentPopup();
+    }
+
+    ImGui::EndPopup();
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+ic::data::View* ic::widget::FinderWidget::GetActiveView() const
+{
+    return application::Application::current_view_type == data::ViewType::RIGHT ? m_parentRightView : m_parentLeftView;
+}
+
+void ic::widget::FinderWidget::Open() const
+{
+    const auto& currentPath{ GetActiveView()->currentPath };
+    const auto root{ m_currentDirectory ? currentPath : currentPath.root_path() };
+
+    // an index of the same root is kept and only checked for changes
+    if (root != m_index->GetRoot())
+    {
+        m_index->Build(root);
+    }
+    else
+    {
+        m_index->Refresh();
+    }
+
+    Search();
+}
+
+void ic::widget::FinderWidget::Search() const
+{
+    m_searchedSize = m_index->GetSize();
+    m_searchTime = std::chrono::steady_clock::now();
+
+    m_results.clear();
+    for (const auto& match : m_index->Find(m_query))
+    {
+        const auto path{ m_index->GetPath(match.node) };
+        m_results.push_back({ match.node, path.filename().string(), path.parent_path().string(), m_index->IsDirectory(match.node) });
+    }
+
+    m_selected = std::min(m_selected, m_results.empty() ? 0 : m_results.size() - 1);
+}
+
+void ic::widget::FinderWidget::Select(const Result& t_result) const
+{
+    const auto path{ m_index->GetPath(t_result.node) };
+    if (std::error_code ec; !IC_PROFILE_FS(STAT, "FinderWidget::Select", std::filesystem::exists(path, ec)))
+    {
+        IC_LOG_WARN("[FinderWidget::Select()] {} no longer exists.", path.string());
+        m_index->Refresh();
+
+        return;
+    }
+
+    const auto viewType{ GetActiveView()->viewType };
+    auto& bus{ application::Application::event_bus };
+
+    if (t_result.isDirectory)
+    {
+        bus.Publish(event::ChangeRootPathEvent(path, viewType));
+    }
+    else
+    {
+        bus.Publish(event::ChangeRootPathEvent(path.parent_path(), viewType));
+        bus.Publish(event::ShowPathInfoEvent(path, viewType, false));
+    }
+
+    ImGui::CloseCurrentPopup();
+}
+
+void ic::widget::FinderWidget::RenderResults() const
+{
+    ImGui::BeginChild("##finderResults", ImVec2(0, -ImGui::GetFrameHeightWithSpacing()), true);
+
+    for (std::size_t i{ 0 }; i < m_results.size(); ++i)
+    {
+        const auto& result{ m_results[i] };
+        const auto label{ std::string(result.isDirectory ? "/" : "").append(result.name).append("##finderResult").append(std::to_string(i)) };
+
+        if (ImGui::Selectable(label.c_str(), i == m_selected, ImGuiSelectableFlags_AllowDoubleClick | ImGuiSelectableFlags_DontClosePopups))
+        {
+            m_selected = i;
+            if (ImGui::IsMouseDoubleClicked(0))
+            {
+                Select(result);
+            }
+        }
+
+        if (i == m_selected && (ImGui::IsKeyPressed(ImGuiKey_DownArrow) || ImGui::IsKeyPressed(ImGuiKey_UpArrow)))
+        {
+            ImGui::SetScrollHereY();
+        }
+
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s", result.directory.c_str());
+    }
+
+    ImGui::EndChild();
+}
@@ -0,0 +1,134 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include "data/FileIndex.h"
+
+namespace ic::data
+{
+    class View;
+}
+
+namespace ic::widget
+{
+    /**
+     * A popup to jump to any file or directory under the root
+     * or the current directory of the active view.
+     */
+    class FinderWidget
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * While the index is built, the results are updated at this interval.
+         */
+        static constexpr std::chrono::milliseconds UPDATE_INTERVAL{ 250 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        FinderWidget() = delete;
+
+        FinderWidget(data::View* t_parentLeftView, data::View* t_parentRightView);
+
+        FinderWidget(const FinderWidget& t_other) = delete;
+        FinderWidget(FinderWidget&& t_other) noexcept = delete;
+        FinderWidget& operator=(const FinderWidget& t_other) = delete;
+        FinderWidget& operator=(FinderWidget&& t_other) noexcept = delete;
+
+        ~FinderWidget() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @return True if the finder is shown while the index is built.
+         */
+        [[nodiscard]] bool IsIndexing() const;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        void Render() const;
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        struct Result
+        {
+            std::uint32_t node;
+            std::string name;
+            std::string directory;
+            bool isDirectory;
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        data::View* m_parentLeftView{ nullptr };
+        data::View* m_parentRightView{ nullptr };
+
+        std::unique_ptr<data::FileIndex> m_index;
+
+        /**
+         * Index the current directory of the active view instead of its root.
+         */
+        mutable bool m_currentDirectory{ false };
+
+        /**
+         * The popup has been shown in the last frame.
+         */
+        mutable bool m_open{ false };
+
+        mutable std::string m_query;
+        mutable std::vector<Result> m_results;
+        mutable std::size_t m_selected{ 0 };
+
+        mutable std::size_t m_searchedSize{ 0 };
+        mutable std::chrono::steady_clock::time_point m_searchTime;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        [[nodiscard]] data::View* GetActiveView() const;
+
+        void Open() const;
+        void Search() const;
+        void Select(const Result& t_result) const;
+
+        void RenderResults() const;
+    };
+}
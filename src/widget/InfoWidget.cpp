@@ -19,6 +19,7 @@
 #include <imgui.h>
 #include "InfoWidget.h"
 #include "IcAssert.h"
+#include "IcProfile.h"
 #include "data/View.h"
 #include "application/Util.h"
 #include "vendor/magic/magic_enum.hpp"
@@ -62,6 +63,8 @@ void ic::widget::InfoWidget::SetSize(const float t_x, const float t_y)
 
 void ic::widget::InfoWidget::Render() const
 {
+    IC_PROFILE_SCOPE("InfoWidget::Render");
+
     IC_ASSERT(m_posX >= 0 && m_posY > 0, "[InfoWidget::Render()] Invalid window position.")
     IC_ASSERT(m_sizeX > 0 && m_sizeY > 0, "[InfoWidget::Render()] Invalid window size.")
 
@@ -81,14 +84,14 @@ void ic::widget::InfoWidget::Render() const
 
     if (!m_parentView->currentSelectedPath.empty())
     {
-        if (std::filesystem::is_directory(m_parentView->currentSelectedPath))
+        if (IC_PROFILE_FS(STAT, "InfoWidget::Render", std::filesystem::is_directory(m_parentView->currentSelectedPath)))
         {
 #if defined(_WIN64) && defined(_MSC_VER)
             ImGui::TextUnformatted(std::string("/").append(application::Util::WstringConv(m_parentView->currentSelectedPath.filename().string())).c_str());
 #elif defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
-            if (std::filesystem::is_symlink(m_parentView->currentSelectedPath))
+            if (IC_PROFILE_FS(LSTAT, "InfoWidget::Render", std::filesystem::is_symlink(m_parentView->currentSelectedPath)))
             {
-                ImGui::TextUnformatted(std::string("-> ").append(std::filesystem::read_symlink(m_parentView->currentSelectedPath).string()).c_str());
+                ImGui::TextUnformatted(std::string("-> ").append(IC_PROFILE_FS(READLINK, "InfoWidget::Render", std::filesystem::read_symlink(m_parentView->currentSelectedPath)).string()).c_str());
             }
             else
             {
@@ -96,14 +99,14 @@ void ic::widget::InfoWidget::Render() const
             }
 #endif
         }
-        else if (std::filesystem::is_regular_file(m_parentView->currentSelectedPath))
+        else if (IC_PROFILE_FS(STAT, "InfoWidget::Render", std::filesystem::is_regular_file(m_parentView->currentSelectedPath)))
         {
 #if defined(_WIN64) && defined(_MSC_VER)
             ImGui::TextUnformatted(application::Util::WstringConv(m_parentView->currentSelectedPath.filename().string()).c_str());
 #elif defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
-            if (std::filesystem::is_symlink(m_parentView->currentSelectedPath))
+            if (IC_PROFILE_FS(LSTAT, "InfoWidget::Render", std::filesystem::is_symlink(m_parentView->currentSelectedPath)))
             {
-                ImGui::TextUnformatted(std::string("-> ").append(std::filesystem::read_symlink(m_parentView->currentSelectedPath).string()).c_str());
+                ImGui::TextUnformatted(std::string("-> ").append(IC_PROFILE_FS(READLINK, "InfoWidget::Render", std::filesystem::read_symlink(m_parentView->currentSelectedPath)).string()).c_str());
             }
             else
             {
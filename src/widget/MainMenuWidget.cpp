@@ -55,10 +55,17 @@ void ic::widget::MainMenuWidget::Render() const
         {
             if (ImGui::MenuItem("Rescan##mainMenuLeftRescan"))
             {
-                application::Application::event_dispatcher.dispatch(
-                    event::IcEventType::DIRTY,
-                    event::DirtyEvent(m_parentLeftView->currentPath, data::ViewType::LEFT)
-                );
+                application::Application::event_bus.Publish(event::DirtyEvent(m_parentLeftView->currentPath, data::ViewType::LEFT));
+            }
+
+            if (ImGui::MenuItem("Directory sizes##mainMenuLeftSizes"))
+            {
+                m_parentLeftView->ComputeDirectorySizes();
+            }
+
+            if (ImGui::MenuItem("Cancel directory sizes##mainMenuLeftCancelSizes", nullptr, false, m_parentLeftView->GetDirectorySizer().IsRunning()))
+            {
+                m_parentLeftView->CancelDirectorySizes();
             }
 
             ImGui::EndMenu();
@@ -67,6 +74,11 @@ void ic::widget::MainMenuWidget::Render() const
         // file
         if (ImGui::BeginMenu("File##mainMenuFile"))
         {
+            if (ImGui::MenuItem("Find file##mainMenuFind", "Ctrl+P"))
+            {
+                application::Application::show_finder = true;
+            }
+
             if (ImGui::MenuItem("Exit##mainMenuExit"))
             {
                 auto event{ std::make_unique<SDL_Event>() };
@@ -77,15 +89,61 @@ void ic::widget::MainMenuWidget::Render() const
             ImGui::EndMenu();
         }
 
+        // display
+        if (ImGui::BeginMenu("Display##mainMenuDisplay"))
+        {
+            auto& sizeFormat{ application::Application::size_format };
+            auto& timeFormat{ application::Application::time_format };
+
+            ImGui::TextDisabled("Size");
+            if (ImGui::MenuItem("Human readable##mainMenuDisplaySizeHuman", nullptr, sizeFormat == data::SizeFormat::HUMAN))
+            {
+                sizeFormat = data::SizeFormat::HUMAN;
+            }
+            if (ImGui::MenuItem("Bytes##mainMenuDisplaySizeBytes", nullptr, sizeFormat == data::SizeFormat::BYTES))
+            {
+                sizeFormat = data::SizeFormat::BYTES;
+            }
+
+            ImGui::Separator();
+
+            ImGui::TextDisabled("Modify time");
+            if (ImGui::MenuItem("Local##mainMenuDisplayTimeLocal", nullptr, timeFormat == data::TimeFormat::LOCAL))
+            {
+                timeFormat = data::TimeFormat::LOCAL;
+            }
+            if (ImGui::MenuItem("ISO##mainMenuDisplayTimeIso", nullptr, timeFormat == data::TimeFormat::ISO))
+            {
+                timeFormat = data::TimeFormat::ISO;
+            }
+            if (ImGui::MenuItem("Relative##mainMenuDisplayTimeRelative", nullptr, timeFormat == data::TimeFormat::RELATIVE))
+            {
+                timeFormat = data::TimeFormat::RELATIVE;
+            }
+
+            ImGui::Separator();
+
+            ImGui::MenuItem("Natural sort order##mainMenuDisplayNatural", nullptr, &application::Application::natural_sort);
+
+            ImGui::EndMenu();
+        }
+
         // right
         if (ImGui::BeginMenu("Right##mainMenuRight"))
         {
             if (ImGui::MenuItem("Rescan##mainMenuRightRescan"))
             {
-                application::Application::event_dispatcher.dispatch(
-                    event::IcEventType::DIRTY,
-                    event::DirtyEvent(m_parentRightView->currentPath, data::ViewType::RIGHT)
-                );
+                application::Application::event_bus.Publish(event::DirtyEvent(m_parentRightView->currentPath, data::ViewType::RIGHT));
+            }
+
+            if (ImGui::MenuItem("Directory sizes##mainMenuRightSizes"))
+            {
+                m_parentRightView->ComputeDirectorySizes();
+            }
+
+            if (ImGui::MenuItem("Cancel directory sizes##mainMenuRightCancelSizes", nullptr, false, m_parentRightView->GetDirectorySizer().IsRunning()))
+            {
+                m_parentRightView->CancelDirectorySizes();
             }
 
             ImGui::EndMenu();
@@ -0,0 +1,230 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <imgui.h>
+#include <string>
+#include "OperationsWidget.h"
+#include "IcAssert.h"
+#include "application/Application.h"
+#include "operation/OperationQueue.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+ic::widget::OperationsWidget::OperationsWidget(operation::OperationQueue* t_operationQueue)
+    : m_operationQueue{ t_operationQueue }
+{
+    IC_ASSERT(m_operationQueue, "[OperationsWidget::OperationsWidget()] Null pointer.")
+
+    IC_LOG_DEBUG("[OperationsWidget::OperationsWidget()] Create OperationsWidget.");
+}
+
+ic::widget::OperationsWidget::~OperationsWidget() noexcept
+{
+    IC_LOG_DEBUG("[OperationsWidget::~OperationsWidget()] Destruct OperationsWidget.");
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void ic::widget::OperationsWidget::Render() const
+{
+    if (!application::Application::show_jobs)
+    {
+        return;
+    }
+
+    m_entryText.Sync(0, 0, application::Application::size_format, application::Application::time_format);
+
+    ImGui::SetNextWindowSize({ 520.0f, 0.0f }, ImGuiCond_Appearing);
+    if (!ImGui::Begin("Jobs##jobs", &application::Application::show_jobs, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings))
+    {
+        ImGui::End();
+        return;
+    }
+
+    const auto& operations{ m_operationQueue->GetOperations() };
+    if (operations.empty())
+    {
+        ImGui::TextDisabled("No jobs.");
+    }
+
+    const operation::Operation* removed{ nullptr };
+    for (const auto& operation : operations)
+    {
+        ImGui::PushID(operation.get());
+        if (RenderOperation(*operation))
+        {
+            removed = operation.get();
+        }
+        ImGui::PopID();
+
+        ImGui::Separator();
+    }
+
+    if (ImGui::Button("Clear finished##jobsClear"))
+    {
+        m_operationQueue->RemoveFinished();
+    }
+    else if (removed)
+    {
+        m_operationQueue->Remove(removed);
+    }
+
+    ImGui::End();
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+bool ic::widget::OperationsWidget::RenderOperation(operation::Operation& t_operation) const
+{
+    const auto& progress{ t_operation.GetProgress() };
+    const auto bytes{ progress.bytes.load() };
+    const auto totalBytes{ progress.totalBytes.load() };
+    const auto files{ progress.files.load() };
+    const auto totalFiles{ progress.totalFiles.load() };
+
+    ImGui::TextUnformatted(t_operation.GetDescription().c_str());
+
+    const char* state;
+    if (t_operation.IsFinished())
+    {
+        state = t_operation.IsCancelled() ? "Cancelled" : "Finished";
+    }
+    else if (t_operation.IsPaused())
+    {
+        state = "Paused";
+    }
+    else
+    {
+        state = t_operation.IsStarted() ? "Running" : "Queued";
+    }
+    ImGui::TextDisabled("%s", state);
+
+    // the priority only matters until the job is started
+    ImGui::SameLine();
+    if (t_operation.IsStarted())
+    {
+        ImGui::TextDisabled("%s priority", PRIORITY_NAMES[static_cast<std::size_t>(t_operation.GetPriority())]);
+    }
+    else
+    {
+        for (std::size_t i{ 0 }; i < PRIORITY_NAMES.size(); ++i)
+        {
+            const auto priority{ static_cast<operation::Priority>(i) };
+
+            ImGui::SameLine();
+            if (ImGui::RadioButton(PRIORITY_NAMES[i], t_operation.GetPriority() == priority))
+            {
+                m_operationQueue->SetPriority(&t_operation, priority);
+            }
+        }
+    }
+
+    // a delete does not count the files first
+    if (totalBytes > 0 || totalFiles > 0)
+    {
+        auto fraction{ 0.0f };
+        if (totalBytes > 0)
+        {
+            fraction = static_cast<float>(static_cast<double>(bytes) / static_cast<double>(totalBytes));
+        }
+        else
+        {
+            fraction = static_cast<float>(static_cast<double>(files) / static_cast<double>(totalFiles));
+        }
+        ImGui::ProgressBar(t_operation.IsFinished() && !t_operation.IsCancelled() ? 1.0f : fraction);
+
+        const std::string done{ m_entryText.GetSize(bytes) };
+        const auto total{ m_entryText.GetSize(totalBytes) };
+        ImGui::Text(
+            "%llu of %llu files, %s of %.*s",
+            static_cast<unsigned long long>(files),
+            static_cast<unsigned long long>(totalFiles),
+            done.c_str(),
+            static_cast<int>(total.size()), total.data()
+        );
+    }
+    else
+    {
+        ImGui::Text("%llu files", static_cast<unsigned long long>(files));
+    }
+
+    const std::string rate{ m_entryText.GetSize(static_cast<std::uint64_t>(t_operation.GetBytesPerSecond())) };
+    ImGui::Text(
+        "%s/s, %.0f files/s, %.1f s",
+        rate.c_str(),
+        t_operation.GetFilesPerSecond(),
+        std::chrono::duration<double>(t_operation.GetElapsed()).count()
+    );
+    if (const auto concurrency{ progress.concurrency.load() }; concurrency > 0 && t_operation.IsStarted() && !t_operation.IsFinished())
+    {
+        ImGui::SameLine();
+        ImGui::Text(", %zu in parallel", concurrency);
+    }
+    if (const auto remaining{ t_operation.GetRemaining() }; remaining && !t_operation.IsFinished())
+    {
+        ImGui::SameLine();
+        ImGui::Text(
+            ", %lld:%02lld left",
+            static_cast<long long>(remaining->count() / 60),
+            static_cast<long long>(remaining->count() % 60)
+        );
+    }
+
+    if (const auto errors{ t_operation.GetErrors() }; !errors.empty())
+    {
+        if (ImGui::TreeNode("##operationErrors", "%zu errors", errors.size()))
+        {
+            for (const auto& error : errors)
+            {
+                ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "%s", error.c_str());
+            }
+            ImGui::TreePop();
+        }
+    }
+
+    if (t_operation.IsFinished())
+    {
+        return ImGui::Button("Close##operationClose", ImVec2(120, 0));
+    }
+
+    if (t_operation.IsPaused())
+    {
+        if (ImGui::Button("Resume##operationResume", ImVec2(120, 0)))
+        {
+            m_operationQueue->Resume(&t_operation);
+        }
+    }
+    else if (ImGui::Button("Pause##operationPause", ImVec2(120, 0)))
+    {
+        m_operationQueue->Pause(&t_operation);
+    }
+
+    ImGui::SameLine();
+    if (ImGui::Button("Cancel##operationCancel", ImVec2(120, 0)))
+    {
+        m_operationQueue->Cancel(&t_operation);
+    }
+
+    return false;
+}
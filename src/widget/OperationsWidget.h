@@ -0,0 +1,92 @@
+// This file is part of the IC project.
+//
+// Copyright (c) 2023. stwe <https://github.com/stwe/ic>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <array>
+#include "data/EntryText.h"
+
+namespace ic::operation
+{
+    class OperationQueue;
+    class Operation;
+}
+
+namespace ic::widget
+{
+    /**
+     * The jobs panel: shows the queued, running and finished file operations
+     * and lets the user pause, resume and cancel them or change their priority.
+     */
+    class OperationsWidget
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * In the order of operation::Priority.
+         */
+        static constexpr std::array<const char*, 3> PRIORITY_NAMES{ "High", "Normal", "Low" };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        OperationsWidget() = delete;
+
+        explicit OperationsWidget(operation::OperationQueue* t_operationQueue);
+
+        OperationsWidget(const OperationsWidget& t_other) = delete;
+        OperationsWidget(OperationsWidget&& t_other) noexcept = delete;
+        OperationsWidget& operator=(const OperationsWidget& t_other) = delete;
+        OperationsWidget& operator=(OperationsWidget&& t_other) noexcept = delete;
+
+        ~OperationsWidget() noexcept;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        void Render() const;
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        operation::OperationQueue* m_operationQueue{ nullptr };
+
+        /**
+         * To format the byte counts.
+         */
+        mutable data::EntryText m_entryText;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * @return True if the operation should be removed.
+         */
+        [[nodiscard]] bool RenderOperation(operation::Operation& t_operation) const;
+    };
+}
@@ -18,9 +18,11 @@
 
 #include "ViewWidget.h"
 #include "IcAssert.h"
+#include "IcProfile.h"
 #include "application/Application.h"
 #include "application/Util.h"
 #include "vendor/magic/magic_enum.hpp"
+#include "vendor/imgui/imgui_stdlib.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -85,8 +87,15 @@ void ic::widget::ViewWidget::Render() const
     ImGui::NewLine();
 
     ImGui::TextUnformatted(m_parentView->currentPath.string().c_str());
+    if (m_parentView->IsScanning())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(scanning ... %zu)", m_parentView->entries.filesAndDirs.size());
+    }
+
+    RenderFilter();
 
-    if (ImGui::BeginTable((std::string("##").append(name).append("filesTable")).c_str(), 3, ImGuiTableFlags_BordersV))
+    if (ImGui::BeginTable((std::string("##").append(name).append("filesTable")).c_str(), COLUMNS, ImGuiTableFlags_BordersV | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable))
     {
         RenderHeader();
         RenderFirstRow();
@@ -104,9 +113,29 @@ void ic::widget::ViewWidget::Render() const
 
 void ic::widget::ViewWidget::RenderHeader() const
 {
-    ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
-    ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed);
-    ImGui::TableSetupColumn("Modify time", ImGuiTableColumnFlags_WidthStretch);
+    // the user id of a column is its sort key
+    ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_DefaultSort, 0.0f, static_cast<ImGuiID>(data::SortKey::NAME));
+    ImGui::TableSetupColumn("Ext", ImGuiTableColumnFlags_WidthFixed, 0.0f, static_cast<ImGuiID>(data::SortKey::EXTENSION));
+    ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, static_cast<ImGuiID>(data::SortKey::SIZE));
+    ImGui::TableSetupColumn("Modify time", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, static_cast<ImGuiID>(data::SortKey::TIME));
+    ImGui::TableSetupScrollFreeze(0, 1);
+
+    auto sortSpec{ m_parentView->GetSortSpec() };
+    sortSpec.natural = application::Application::natural_sort;
+
+    if (auto* sortSpecs{ ImGui::TableGetSortSpecs() }; sortSpecs && sortSpecs->SpecsDirty)
+    {
+        if (sortSpecs->SpecsCount > 0)
+        {
+            sortSpec.key = static_cast<data::SortKey>(sortSpecs->Specs[0].ColumnUserID);
+            sortSpec.descending = sortSpecs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+        }
+
+        sortSpecs->SpecsDirty = false;
+    }
+
+    // only recorded: the rows must not change while they are rendered
+    m_parentView->RequestSort(sortSpec);
 
     ImGuiStyle& style = ImGui::GetStyle();
     if (m_parentView->viewType == application::Application::current_view_type)
@@ -127,7 +156,7 @@ void ic::widget::ViewWidget::RenderFirstRow() const
     {
         ImGui::TableNextRow();
 
-        for (auto column{ 0 }; column < 3; ++column)
+        for (auto column{ 0 }; column < COLUMNS; ++column)
         {
             ImGui::TableSetColumnIndex(column);
 
@@ -138,10 +167,7 @@ void ic::widget::ViewWidget::RenderFirstRow() const
                 {
                     if (ImGui::IsMouseDoubleClicked(0))
                     {
-                        application::Application::event_dispatcher.dispatch(
-                            event::IcEventType::UP_DIR,
-                            event::UpDirEvent(m_parentView->currentPath, m_parentView->viewType)
-                        );
+                        application::Application::event_bus.Publish(event::UpDirEvent(m_parentView->currentPath, m_parentView->viewType));
                     }
                     else
                     {
@@ -151,7 +177,7 @@ void ic::widget::ViewWidget::RenderFirstRow() const
                 ImGui::PopID();
             }
 
-            if (column == 1)
+            if (column == 2)
             {
                 ImGui::Text("UP--DIR");
             }
@@ -159,60 +185,140 @@ void ic::widget::ViewWidget::RenderFirstRow() const
     }
 }
 
+void ic::widget::ViewWidget::RenderFilter() const
+{
+    // type-ahead: typing in the panel goes to the filter
+    if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) &&
+        !ImGui::IsAnyItemActive() &&
+        !ImGui::GetIO().InputQueueCharacters.empty())
+    {
+        ImGui::SetKeyboardFocusHere();
+    }
+
+    const auto name{ std::string(magic_enum::enum_name(m_parentView->viewType)) };
+
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    ImGui::InputTextWithHint((std::string("##filter").append(name)).c_str(), "Filter", &m_parentView->filterQuery);
+
+    if (const auto& filter{ m_parentView->GetFilter() }; filter.IsActive())
+    {
+        ImGui::TextDisabled("%zu of %zu entries", filter.GetRows().size(), m_parentView->entries.rows.size());
+    }
+}
+
 void ic::widget::ViewWidget::RenderRows() const
 {
-    auto id{ 1 };
-    for (const auto& entry : m_parentView->entries.filesAndDirs)
+    IC_PROFILE_SCOPE("ViewWidget::RenderRows");
+
+    const auto& entries{ m_parentView->entries };
+    const auto& filter{ m_parentView->GetFilter() };
+
+    m_entryText.Sync(
+        entries.generation,
+        entries.filesAndDirs.size(),
+        application::Application::size_format,
+        application::Application::time_format
+    );
+
+    // only the visible rows are submitted
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(filter.IsActive() ? filter.GetRows().size() : entries.rows.size()));
+    while (clipper.Step())
     {
-        ImGui::PushID(id);
+        for (auto i{ clipper.DisplayStart }; i < clipper.DisplayEnd; ++i)
+        {
+            const auto row{ filter.IsActive() ? filter.GetRows()[i] : static_cast<std::uint32_t>(i) };
+            RenderRow(entries.At(row), entries.rows[row].index, static_cast<int>(row) + 1);
+        }
+    }
+}
 
-        ImGui::TableNextRow();
+void ic::widget::ViewWidget::RenderRow(const data::Entry& t_entry, const std::uint32_t t_index, const int t_id) const
+{
+    ImGui::PushID(t_id);
+
+    ImGui::TableNextRow();
 
-        for (int column = 0; column < 3; column++)
+    for (int column = 0; column < COLUMNS; column++)
+    {
+        ImGui::TableSetColumnIndex(column);
+
+        if (column == 0)
         {
-            ImGui::TableSetColumnIndex(column);
+            if (t_entry.IsFile())
+            {
+                RenderFile(t_entry);
+            }
+            else if (t_entry.IsDirectory())
+            {
+                RenderDirectory(t_entry);
+            }
+        }
 
-            if (column == 0)
+        if (column == 1)
+        {
+            if (t_entry.IsFile())
             {
-                if (std::filesystem::is_regular_file(entry))
-                {
-                    RenderFile(entry);
-                }
-                else if (std::filesystem::is_directory(entry))
-                {
-                    if (RenderDirectory(entry))
-                    {
-                        // return if select - m_parentView->entries.filesAndDirs is empty!
-                        ImGui::PopID();
-                        return;
-                    }
-                }
+                const auto extension{ data::Entry::GetExtension(t_entry.name) };
+                ImGui::TextUnformatted(extension.data(), extension.data() + extension.size());
             }
+        }
 
-            if (column == 1)
+        if (column == 2)
+        {
+            if (t_entry.IsFile())
             {
-                if (std::filesystem::is_regular_file(entry))
-                {
-                    ImGui::Text("%s", application::Util::GetHumanReadableSize(std::filesystem::file_size(entry)).c_str());
-                }
-                else
-                {
-                    ImGui::Text("");
-                }
+                const auto size{ m_entryText.GetSize(t_index, t_entry) };
+                ImGui::TextUnformatted(size.data(), size.data() + size.size());
             }
+            else if (const auto totals{ m_parentView->GetDirectorySizer().Get(t_entry.path) })
+            {
+                RenderDirectorySize(*totals);
+            }
+            else
+            {
+                ImGui::Text("");
+            }
+        }
 
-            if (column == 2)
+        if (column == 3)
+        {
+            if (t_entry.IsFile() || t_entry.IsDirectory())
             {
-                if (std::filesystem::is_regular_file(entry) || std::filesystem::is_directory(entry))
-                {
-                    const auto fileTime{ std::filesystem::last_write_time(entry) };
-                    ImGui::Text("%s", application::Util::LastWriteTimeToStr(fileTime).c_str());
-                }
+                const auto time{ m_entryText.GetTime(t_index, t_entry) };
+                ImGui::TextUnformatted(time.data(), time.data() + time.size());
             }
         }
+    }
+
+    ImGui::PopID();
+}
+
+void ic::widget::ViewWidget::RenderDirectorySize(const data::DirectorySizer::Totals& t_totals) const
+{
+    // a total that is still growing is dimmed
+    const auto size{ m_entryText.GetSize(t_totals.apparent) };
+    if (t_totals.finished)
+    {
+        ImGui::TextUnformatted(size.data(), size.data() + size.size());
+    }
+    else
+    {
+        ImGui::TextDisabled("%.*s", static_cast<int>(size.size()), size.data());
+    }
 
-        ImGui::PopID();
-        ++id;
+    if (ImGui::IsItemHovered())
+    {
+        const std::string apparent{ size };
+        const auto allocated{ m_entryText.GetSize(t_totals.allocated) };
+        ImGui::SetTooltip(
+            "Apparent size: %s\nAllocated size: %.*s\n%llu files, %llu directories%s",
+            apparent.c_str(),
+            static_cast<int>(allocated.size()), allocated.data(),
+            static_cast<unsigned long long>(t_totals.files),
+            static_cast<unsigned long long>(t_totals.directories),
+            t_totals.finished ? "" : "\nStill counting ..."
+        );
     }
 }
 
@@ -223,10 +329,7 @@ void ic::widget::ViewWidget::RenderDriveLetters() const
     {
         if (std::string label(1, drive); ImGui::Button(label.c_str()))
         {
-            application::Application::event_dispatcher.dispatch(
-                event::IcEventType::CHANGE_ROOT_PATH,
-                event::ChangeRootPathEvent(std::filesystem::path(label.append(":\\")), m_parentView->viewType)
-            );
+            application::Application::event_bus.Publish(event::ChangeRootPathEvent(std::filesystem::path(label.append(":\\")), m_parentView->viewType));
         }
         ImGui::SameLine();
     }
@@ -237,118 +340,126 @@ void ic::widget::ViewWidget::RenderDriveLetters() const
 // Render
 //-------------------------------------------------
 
-bool ic::widget::ViewWidget::RenderDirectory(const std::filesystem::path& t_path) const
+void ic::widget::ViewWidget::RenderDirectory(const data::Entry& t_entry) const
 {
     std::string pre = "/";
 
 #if defined(_WIN64) && defined(_MSC_VER)
-    if (!application::Util::IsAccessDenied(t_path.wstring()) && !application::Util::IsJunctionDirectory(t_path.wstring()))
+    if (t_entry.accessible && !t_entry.junction)
     {
-        if (application::Util::IsHiddenDirectory(t_path.wstring()))
+        if (t_entry.hidden)
         {
-            PushHiddenColor(t_path);
+            PushHiddenColor(t_entry.path);
         }
         else
         {
-            PushDefaultColor(t_path);
+            PushDefaultColor(t_entry.path);
         }
 
-        if (ImGui::Selectable(pre.append(application::Util::WstringConv(t_path)).c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
+        if (ImGui::Selectable(pre.append(t_entry.name).c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
         {
-            return DirectoryDispatchEvents(t_path);
+            DirectoryDispatchEvents(t_entry.path);
+        }
+
+        if (ImGui::IsItemHovered())
+        {
+            HoverDispatchEvents(t_entry.path);
         }
 
         ImGui::PopStyleColor(1);
     }
     else
     {
-        if(application::Util::IsJunctionDirectory(t_path.wstring()))
+        if (t_entry.junction)
         {
             pre = "~";
-            RenderAccessDenied(pre.append(application::Util::WstringConv(t_path)).c_str(), ImVec4(0.0f, 0.0f, 1.0f, 1.0f));
+            RenderAccessDenied(pre.append(t_entry.name).c_str(), ImVec4(0.0f, 0.0f, 1.0f, 1.0f));
         }
         else
         {
-            RenderAccessDenied(pre.append(application::Util::WstringConv(t_path)).c_str(), ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
+            RenderAccessDenied(pre.append(t_entry.name).c_str(), ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
         }
     }
 #elif defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
-    if (access(t_path.string().c_str(), R_OK) == 0)
+    if (t_entry.accessible)
     {
-        if (std::filesystem::is_symlink(t_path))
+        if (t_entry.symlink)
         {
             pre = "~";
-            PushSymlinkColor(t_path);
+            PushSymlinkColor(t_entry.path);
         }
-        else if (application::Util::IsHidden(t_path))
+        else if (t_entry.hidden)
         {
-            PushHiddenColor(t_path);
+            PushHiddenColor(t_entry.path);
         }
         else
         {
-            PushDefaultColor(t_path);
+            PushDefaultColor(t_entry.path);
         }
 
-        if (ImGui::Selectable(pre.append(t_path.filename().string()).c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
+        if (ImGui::Selectable(pre.append(t_entry.name).c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
         {
-            return DirectoryDispatchEvents(t_path);
+            DirectoryDispatchEvents(t_entry.path);
+        }
+
+        if (ImGui::IsItemHovered())
+        {
+            HoverDispatchEvents(t_entry.path);
         }
 
         ImGui::PopStyleColor(1);
     }
     else
     {
-        if (std::filesystem::is_symlink(t_path))
+        if (t_entry.symlink)
         {
             pre = "~";
         }
 
-        RenderAccessDenied(t_path, pre);
+        RenderAccessDenied(t_entry, pre);
     }
 #endif
-
-    return false;
 }
 
-void ic::widget::ViewWidget::RenderFile(const std::filesystem::path& t_path) const
+void ic::widget::ViewWidget::RenderFile(const data::Entry& t_entry) const
 {
 #if defined(_WIN64) && defined(_MSC_VER)
-    PushDefaultColor(t_path);
+    PushDefaultColor(t_entry.path);
 
-    if (ImGui::Selectable(application::Util::WstringConv(t_path).c_str(), false))
+    if (ImGui::Selectable(t_entry.name.c_str(), false))
     {
-        FileDispatchEvents(t_path);
+        FileDispatchEvents(t_entry.path);
     }
 
     ImGui::PopStyleColor(1);
 #elif defined(__linux__) && defined(__GNUC__) && (__GNUC__ >= 9)
     std::string pre;
-    if (access(t_path.string().c_str(), R_OK) == 0)
+    if (t_entry.accessible)
     {
-        if (std::filesystem::is_symlink(t_path))
+        if (t_entry.symlink)
         {
             pre = "@";
-            PushSymlinkColor(t_path);
+            PushSymlinkColor(t_entry.path);
         }
-        else if (application::Util::IsHidden(t_path))
+        else if (t_entry.hidden)
         {
-            PushHiddenColor(t_path);
+            PushHiddenColor(t_entry.path);
         }
         else
         {
-            PushDefaultColor(t_path);
+            PushDefaultColor(t_entry.path);
         }
 
-        if (ImGui::Selectable(pre.append(t_path.filename().string()).c_str(), false))
+        if (ImGui::Selectable(pre.append(t_entry.name).c_str(), false))
         {
-            FileDispatchEvents(t_path);
+            FileDispatchEvents(t_entry.path);
         }
 
         ImGui::PopStyleColor(1);
     }
     else
     {
-        RenderAccessDenied(t_path, pre);
+        RenderAccessDenied(t_entry, pre);
     }
 #endif
 }
@@ -389,60 +500,49 @@ void ic::widget::ViewWidget::PushDefaultColor(const std::filesystem::path& t_pat
     }
 }
 
-bool ic::widget::ViewWidget::DirectoryDispatchEvents(const std::filesystem::path& t_path) const
+void ic::widget::ViewWidget::DirectoryDispatchEvents(const std::filesystem::path& t_path) const
 {
     // double click
     if (ImGui::IsMouseDoubleClicked(0))
     {
-        application::Application::event_dispatcher.dispatch(
-            event::IcEventType::IN_DIR,
-            event::InDirEvent(t_path, m_parentView->viewType)
-        );
-
-        ImGui::PopStyleColor(1);
+        application::Application::event_bus.Publish(event::InDirEvent(t_path, m_parentView->viewType));
 
-        return true;
+        return;
     }
 
     // single click
-    application::Application::event_dispatcher.dispatch(
-        event::IcEventType::SHOW_PATH_INFO,
-        event::ShowPathInfoEvent(t_path, m_parentView->viewType)
-    );
+    application::Application::event_bus.Publish(event::ShowPathInfoEvent(t_path, m_parentView->viewType, true));
 
     if (ImGui::GetIO().KeyShift)
     {
-        application::Application::event_dispatcher.dispatch(
-            event::IcEventType::SELECT_PATH,
-            event::SelectPathEvent(t_path, m_parentView->viewType)
-        );
+        application::Application::event_bus.Publish(event::SelectPathEvent(t_path, m_parentView->viewType));
     }
-
-    ImGui::PopStyleColor(1);
-
-    return false;
 }
 
 void ic::widget::ViewWidget::FileDispatchEvents(const std::filesystem::path& t_path) const
 {
-    application::Application::event_dispatcher.dispatch(
-        event::IcEventType::SHOW_PATH_INFO,
-        event::ShowPathInfoEvent(t_path, m_parentView->viewType)
-    );
+    application::Application::event_bus.Publish(event::ShowPathInfoEvent(t_path, m_parentView->viewType, false));
 
     if (ImGui::GetIO().KeyShift)
     {
-        application::Application::event_dispatcher.dispatch(
-            event::IcEventType::SELECT_PATH,
-            event::SelectPathEvent(t_path, m_parentView->viewType)
-        );
+        application::Application::event_bus.Publish(event::SelectPathEvent(t_path, m_parentView->viewType));
+    }
+}
+
+void ic::widget::ViewWidget::HoverDispatchEvents(const std::filesystem::path& t_path) const
+{
+    // only when the mouse enters another directory
+    if (t_path != m_hoveredPath)
+    {
+        m_hoveredPath = t_path;
+        application::Application::event_bus.Publish(event::HoverPathEvent(t_path, m_parentView->viewType));
     }
 }
 
-void ic::widget::ViewWidget::RenderAccessDenied(const std::filesystem::path& t_path, const std::string& t_prefix)
+void ic::widget::ViewWidget::RenderAccessDenied(const data::Entry& t_entry, const std::string& t_prefix)
 {
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.0f, 0.0f, 1.0f)); // red
-    ImGui::TextUnformatted(std::string(t_prefix).append(t_path.filename().string()).c_str());
+    ImGui::TextUnformatted(std::string(t_prefix).append(t_entry.name).c_str());
     ImGui::PopStyleColor(1);
 }
 
@@ -20,10 +20,14 @@
 
 #include <imgui.h>
 #include <filesystem>
+#include <cstdint>
+#include "data/EntryText.h"
+#include "data/DirectorySizer.h"
 
 namespace ic::data
 {
     class View;
+    struct Entry;
 }
 
 namespace ic::widget
@@ -31,6 +35,15 @@ namespace ic::widget
     class ViewWidget
     {
     public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Name, extension, size and modify time.
+         */
+        static constexpr int COLUMNS{ 4 };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -73,13 +86,26 @@ namespace ic::widget
         float m_sizeX{ -1.0f };
         float m_sizeY{ -1.0f };
 
+        /**
+         * The last directory under the mouse.
+         */
+        mutable std::filesystem::path m_hoveredPath;
+
+        /**
+         * The formatted sizes and times of the entries.
+         */
+        mutable data::EntryText m_entryText;
+
         //-------------------------------------------------
         // Helper
         //-------------------------------------------------
 
         void RenderHeader() const;
         void RenderFirstRow() const;
+        void RenderFilter() const;
         void RenderRows() const;
+        void RenderRow(const data::Entry& t_entry, std::uint32_t t_index, int t_id) const;
+        void RenderDirectorySize(const data::DirectorySizer::Totals& t_totals) const;
 
 #if defined(_WIN64) && defined(_MSC_VER)
         void RenderDriveLetters() const;
@@ -89,17 +115,18 @@ namespace ic::widget
         // Render
         //-------------------------------------------------
 
-        [[nodiscard]] bool RenderDirectory(const std::filesystem::path& t_path) const;
-        void RenderFile(const std::filesystem::path& t_path) const;
+        void RenderDirectory(const data::Entry& t_entry) const;
+        void RenderFile(const data::Entry& t_entry) const;
 
         void PushSymlinkColor(const std::filesystem::path& t_path) const;
         void PushHiddenColor(const std::filesystem::path& t_path) const;
         void PushDefaultColor(const std::filesystem::path& t_path) const;
 
-        [[nodiscard]] bool DirectoryDispatchEvents(const std::filesystem::path& t_path) const;
+        void DirectoryDispatchEvents(const std::filesystem::path& t_path) const;
         void FileDispatchEvents(const std::filesystem::path& t_path) const;
+        void HoverDispatchEvents(const std::filesystem::path& t_path) const;
 
-        static void RenderAccessDenied(const std::filesystem::path& t_path, const std::string& t_prefix);
+        static void RenderAccessDenied(const data::Entry& t_entry, const std::string& t_prefix);
         static void RenderAccessDenied(const char* t_pathStr, ImVec4 t_color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
     };
 }